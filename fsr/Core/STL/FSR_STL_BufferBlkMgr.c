@@ -1,939 +1,1494 @@
-/**
- *   @mainpage   Flex Sector Remapper
- *
- *   @section Intro
- *       Flash Translation Layer for Flex-OneNAND and OneNAND
- *    
- *    @section  Copyright
- *            COPYRIGHT. 2007-2009 SAMSUNG ELECTRONICS CO., LTD.               
- *                            ALL RIGHTS RESERVED                              
- *                                                                             
- *     Permission is hereby granted to licensees of Samsung Electronics        
- *     Co., Ltd. products to use or abstract this computer program for the     
- *     sole purpose of implementing a product based on Samsung                 
- *     Electronics Co., Ltd. products. No other rights to reproduce, use,      
- *     or disseminate this computer program, whether in part or in whole,      
- *     are granted.                                                            
- *                                                                             
- *     Samsung Electronics Co., Ltd. makes no representation or warranties     
- *     with respect to the performance of this computer program, and           
- *     specifically disclaims any responsibility for any damages,              
- *     special or consequential, connected with the use of this program.       
- *
- *     @section Description
- *
- */
-
-/** 
- *  @file       FSR_STL_BufferBlkMgr.c
- *  @brief      This file contains buffer block related codes.
- *  @author     Wonmoon Cheon
- *  @date       23-MAY-2007
- *  @remark
- *  REVISION HISTORY
- *  @n  23-MAY-2007 [Wonmoon Cheon] : first writing
- *  @n  29-JAN-2008 [MinYoung Kim] : dead code elimination
- *
- */
-
-/*****************************************************************************/
-/* Header file inclusions                                                    */
-/*****************************************************************************/
-#include "FSR.h"
-
-#include "FSR_STL_CommonType.h"
-#include "FSR_STL_Config.h"
-#include "FSR_STL_Interface.h"
-#include "FSR_STL_Types.h"
-#include "FSR_STL_Common.h"
-
-/*****************************************************************************/
-/* Global variable definitions                                               */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Imported variable declarations                                            */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Imported function prototype                                               */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Local macro                                                               */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Local type defines                                                        */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Local constant definitions                                                */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Local (static) function prototype                                         */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Local (static)  Function Definition                                       */
-/*****************************************************************************/
-
-/*****************************************************************************/
-/* Global Function Definition                                                */
-/*****************************************************************************/
-
-#if (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1)
-
-/**
- * @brief       This function writes the buffered page into log block.
- *
- * @param[in]   pstZone                     : Zone object
- *
- * @return      FSR_STL_SUCCESS
- *
- * @author      Jaesoo Lee
- * @version     1.1.0
- */
-PUBLIC INT32 
-FSR_STL_FlushBufferPage    (STLZoneObj *pstZone)
-{
-    RBWDevInfo     *pstDev;
-    STLLogGrpHdl   *pstLogGrp       = NULL;
-    STLLog         *pstLog          = NULL;
-    PADDR           nLpn;
-    PADDR           nDstVpn;
-    PADDR           nSrcVpn;
-    STLBUCtxObj    *pstBUCtx;
-    PADDR           nLogSrcVpn      = NULL_VPN;
-    SBITMAP         nLogSrcBitmap   = 0;
-    BOOL32          bPageDeleted    = FALSE32;
-    VFLParam       *pstVFLParam;
-    UINT16          nSctPerVPg      = (UINT16)pstZone->pstDevInfo->nSecPerVPg;
-    INT32           nRet            = FSR_STL_SUCCESS;
-    UINT16          nNumExtSData;
-
-    FSR_STACK_VAR;
-    FSR_STACK_END;
-    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-        (TEXT("[SIF:IN ]  ++%s()\r\n"), __FSR_FUNC__));
-
-    /* Get device info pointer */
-    pstDev = pstZone->pstDevInfo;
-
-    pstBUCtx = pstZone->pstBUCtxObj;
-
-    nNumExtSData = (nSctPerVPg == STL_2KB_PG) ? nSctPerVPg >> 1 : nSctPerVPg;
-
-    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_INF,
-        (TEXT("[SIF:INF] (nVolID:%d, nZoneID:%d, nBufferedLpn:%d, nValidSBitmap:%08b)\r\n"),
-            pstZone->nVolID, pstZone->nZoneID, pstBUCtx->nBufferedLpn, pstBUCtx->nValidSBitmap));
-
-#if (OP_SUPPORT_RUNTIME_PMT_BUILDING == 1)
-    /* Execute Run time scanning */
-    nRet = FSR_STL_ScanActLogBlock(pstZone,pstBUCtx->nBufferedDgn);
-    if (nRet != FSR_STL_SUCCESS)
-    {
-        FSR_DBZ_RTLMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR, 
-            (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
-            __FSR_FUNC__, __LINE__, nRet));
-        return nRet;
-    }
-#endif /*OP_SUPPORT_RUNTIME_PMT_BUILDING*/
-
-    if (pstBUCtx->nBufState == STL_BUFSTATE_CLEAN)
-    {
-        FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-            (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-        return nRet;
-    }
-
-    FSR_ASSERT(pstBUCtx->nBufferedLpn != NULL_VPN);
-
-    pstVFLParam = FSR_STL_AllocVFLParam(pstZone);
-
-    /*
-     * In order to avoid deadlock, we change the buf state a priori.
-     * Change the buffer state to CLEAN
-     */
-    STL_BUFFER_CTX_AFTER_FLUSH(pstBUCtx);
-
-    /* LPN to write */
-    nLpn = pstBUCtx->nBufferedLpn;
-
-    /*
-     * Before we flush the buffered page into log block, we need an active log
-     * to flush it. 
-     */
-
-    pstLogGrp = FSR_STL_PrepareActLGrp(pstZone, nLpn);
-    if (pstLogGrp == NULL)
-    {
-        FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR,
-            (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
-                __FSR_FUNC__, __LINE__, FSR_STL_ERR_NEW_LOGGRP));
-        return FSR_STL_ERR_NEW_LOGGRP;
-    }
-
-    nRet = FSR_STL_GetLogToWrite(pstZone, nLpn, pstLogGrp, &pstLog, NULL);
-    if (nRet != FSR_STL_SUCCESS)
-    {
-        FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR,
-            (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
-                __FSR_FUNC__, __LINE__, nRet));
-        return nRet;
-    }
-    /* Get clean page address of the log */
-    nDstVpn = FSR_STL_GetLogCPN(pstZone, pstLog, nLpn);
-
-    /* Increase the clean page offset of the log */
-    pstLog->nCPOffs++;
-
-#if (OP_SUPPORT_MLC_LSB_ONLY == 1)
-    /*
-     * For MLC LSB only mode, we moves the clean page offset according to the
-     * LSB/MSB page address scramble.
-     */
-
-    FSR_STL_CheckMLCFastMode(pstZone, pstLog);
-#endif  /* (OP_SUPPORT_MLC_LSB_ONLY == 1) */
-
-    /*
-     * nBufferedVpn points the buffered page position
-     * there is always only one valid buffer page in a buffer block.
-     */
-     
-    nSrcVpn = pstBUCtx->nBufferedVpn;
-
-    if (pstBUCtx->nValidSBitmap != pstDev->nFullSBitmapPerVPg)
-    {
-        /*
-         * Some scts from the end of page are missing 
-         * find out the old source VPN
-         */
-         
-        nRet = FSR_STL_GetLpn2Vpn(pstZone, nLpn, &nLogSrcVpn, &bPageDeleted);
-
-        if (nRet != FSR_STL_SUCCESS)
-        {
-            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-            return nRet;
-        }
-
-        if (!bPageDeleted)
-        {
-            nLogSrcBitmap = pstDev->nFullSBitmapPerVPg & ~(pstBUCtx->nValidSBitmap);
-        }
-        else
-        {
-            nLogSrcBitmap = 0;
-        }
-    }
-
-    /* Initialize VFL params */
-    pstVFLParam->bPgSizeBuf = FALSE32;
-    pstVFLParam->bUserData  = FALSE32;
-    pstVFLParam->bSpare     = TRUE32;
-    pstVFLParam->nNumOfPgs  = 1;
-    pstVFLParam->pData      = (UINT8 *)pstZone->pTempMetaPgBuf;
-    pstVFLParam->pExtParam  = FSR_STL_AllocVFLExtParam(pstZone);
-
-    FSR_STL_InitCRCs(pstZone, pstVFLParam);
-    pstVFLParam->pExtParam->nNumExtSData = nNumExtSData;
-
-    if (!nLogSrcBitmap)
-    {
-        pstVFLParam->nBitmap = 0;
-
-        FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstVFLParam, TRUE32);
-
-        nRet = FSR_STL_Convert_ExtParam(pstZone, pstVFLParam);
-
-        nRet = FSR_STL_FlashModiCopybackCRC(pstZone, nSrcVpn, nDstVpn, pstVFLParam);
-        if (nRet != FSR_BML_SUCCESS)
-        {
-            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-            return nRet;
-        }
-    }
-    else
-    {
-        /* Note that buffered data is always the most recent */
-        pstVFLParam->nBitmap   = pstBUCtx->nValidSBitmap;
-        pstVFLParam->bUserData = FALSE32;
-
-        nRet = FSR_STL_FlashRead(pstZone, nSrcVpn, pstVFLParam, FALSE32);
-        if (nRet != FSR_BML_SUCCESS)
-        {
-            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-            return nRet;
-        }
-
-        /* We guarantee that the CRC in buffer is always valid*/
-        FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstVFLParam, TRUE32);
-
-        nRet = FSR_STL_Convert_ExtParam(pstZone, pstVFLParam);
-
-        nRet = FSR_STL_FlashModiCopybackCRC(pstZone, nLogSrcVpn, nDstVpn, pstVFLParam);
-        if (nRet != FSR_BML_SUCCESS)
-        {
-            return nRet;
-        }
-    }
-
-    /* Update PMT of log group */
-    FSR_STL_UpdatePMT(pstZone, pstLogGrp, pstLog, nLpn, nDstVpn);
-    FSR_STL_UpdatePMTCost(pstZone, pstLogGrp);
-
-    /* Change the state of log block */
-    FSR_STL_ChangeLogState(pstZone, pstLogGrp, pstLog, nLpn);
-
-#if (OP_SUPPORT_STATISTICS_INFO == 1)
-    /* Experimental data generation for analysis */
-    pstZone->pstStats->nTotalLogPgmCnt++;
-#endif
-
-#if (OP_SUPPORT_STATISTICS_INFO == 1)
-    pstZone->pstStats->nBufferMissCnt++;
-#endif
-
-    FSR_STL_FreeVFLParam(pstZone,
-                            pstVFLParam);
-
-    FSR_STL_FreeVFLExtParam(pstZone,
-                            pstVFLParam->pExtParam);
-
-
-    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-    return FSR_STL_SUCCESS;
-}
-
-/**
- *  @brief      This function determines where to write, buffer or log block. 
- * 
- *  @param[in]  pstZone       : zone object
- *  @param[in]  pstLog        : log object
- *  @param[in]  pstParam      : VFL parameter object
- *  @param[in]  nTrTotalSize  : the size of the transaction
- *
- *  @return     TRUE32  : buffer block write
- *  @return     FALSE32 : log block write
- *
- *  @author     Jaesoo Lee
- *  @version    1.1.0
- */
-
-PUBLIC BOOL32 
-FSR_STL_DetermineBufferWrite   (STLZoneObj     *pstZone,
-                                STLLog         *pstLog,
-                                VFLParam       *pstParam,
-                                UINT32          nTrTotalSize)
-{
-    RBWDevInfo     *pstDev;
-    STLBUCtxObj   *pstBUCtx;
-    BOOL32          bBufferWrite = FALSE32;
-    UINT32          nSctPerVPg;
-    PADDR           nLpn;
-    POFFSET         nCurPOffs = 0;
-    POFFSET         nExpectedPOffs = 0;
-
-    FSR_STACK_VAR;
-    FSR_STACK_END;
-
-    /* Get the buffer unit context */
-    pstBUCtx = pstZone->pstBUCtxObj;
-
-    nLpn = pstParam->nLpn;
-
-    /* Get device info pointer */
-    pstDev = pstZone->pstDevInfo;
-
-    nSctPerVPg = pstZone->pstDevInfo->nSecPerVPg;
-
-    /* Determine where to write, buffer or log.*/
-    if ((nLpn == pstBUCtx->nBufferedLpn && /* overwrite case */
-    (pstParam->nBitmap &pstBUCtx->nValidSBitmap)))
-    {
-        bBufferWrite = TRUE32;
-    }
-    else if (!(pstParam->nBitmap &(1 << (nSctPerVPg - 1))))
-    {
-        /* end missing case */
-        if (nTrTotalSize >= nSctPerVPg)
-        {
-            if ((pstLog->nState &LS_STATES_BIT_MASK) == LS_ALLOC)
-            {
-                if (GET_REMAINDER(nLpn, pstDev->nPagesPerSbShift) == 0)
-                {
-                    bBufferWrite = TRUE32;
-                }
-            }
-            else if ((pstLog->nState &LS_STATES_BIT_MASK) == LS_SEQ)
-            {
-                nExpectedPOffs = (POFFSET)GET_REMAINDER(pstLog->nCPOffs, pstDev->nPagesPerSbShift);
-                nCurPOffs = (POFFSET)GET_REMAINDER(nLpn, pstDev->nPagesPerSbShift);
-
-                if (nExpectedPOffs == nCurPOffs)
-                {
-                    bBufferWrite = TRUE32;
-                }
-            }
-        }
-    }
-    return bBufferWrite;
-}
-
-/**
- *  @brief          This function writes the specified nLpn page into
- *  @n              buffer block.
- * 
- *  @param[in]      pstZone     : partition object
- *  @param[in]      pstLogGrp   : log group object
- *  @param[in]      pstLog      : log pointer
- *  @param[in]      pstParam    : VFL parameter object
- *
- *  @return         FSR_STL_SUCCESS
- *
- *  @author         Jaesoo Lee
- *  @version        1.1.0
- */
-PUBLIC INT32
-FSR_STL_WriteSinglePage    (STLZoneObj     *pstZone,
-                            STLLogGrpHdl   *pstLogGrp,
-                            STLLog         *pstLog,
-                            VFLParam       *pstParam,
-                            UINT32 nTrTotalSize,
-                            BOOL32 bConfirmPage)
-{
-    const   RBWDevInfo *pstDev      = pstZone->pstDevInfo;
-    STLCtxInfoHdl      *pstCtx      = pstZone->pstCtxHdl;
-    STLCtxInfoFm       *pstCtxFm    = pstCtx->pstFm;
-    STLBUCtxObj    *pstBUCtx;
-
-    PADDR           nLpn;
-    POFFSET         nBufNumMaxPgs = 0;
-
-    BADDR           nBBlkVbn;
-    UINT32          nBBlkEC = 0;
-
-    PADDR           nBufSrcVpn = NULL_VPN;
-    SBITMAP         nBufSrcBitmap = 0;
-    PADDR           nLogSrcVpn = NULL_VPN;
-    SBITMAP         nLogSrcBitmap = 0;
-    PADDR           nDstVpn = NULL_VPN;
-    SBITMAP         nDstBitmap = 0;
-    PADDR           nSrcVpn = NULL_VPN;
-    SBITMAP         nSrcBitmap = 0;
-
-    BOOL32          bPageDeleted = FALSE32;
-    VFLParam       *pstVFLParam;
-    UINT8          *pCurBufPos;
-    UINT8          *pCurDataPos;
-    BOOL32          bStartCopied = FALSE32;
-
-    const   UINT16  nSctPerVPg      = (UINT16)(pstDev->nSecPerVPg);
-    BOOL32          bBufferWrite    = FALSE32;
-    UINT32          nIdx            = 0;
-    INT32           nRet;
-    BOOL32          bCRCValid = FALSE32;
-    UINT32         *pnCurDstCRC;
-    UINT32         *pnCurSrcCrc;
-    UINT16          nNumExtSData;
-
-    FSR_STACK_VAR;
-    FSR_STACK_END;
-    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-        (TEXT("[SIF:IN ]  ++%s()\r\n"), __FSR_FUNC__));
-
-    FSR_ASSERT(pstLogGrp->pstFm->nDgn != NULL_DGN);
-    FSR_ASSERT(pstLog->nVbn != NULL_VBN);
-    FSR_ASSERT(pstParam->nNumOfPgs == 1);
-
-    /* When the OneNand 2K device, we only use 2 extensive meta data */
-    nNumExtSData = (nSctPerVPg == STL_2KB_PG) ? nSctPerVPg >> 1 : nSctPerVPg;
-
-    /* Get the buffer unit context */
-    pstBUCtx = pstZone->pstBUCtxObj;
-
-    nLpn = pstParam->nLpn;
-
-    pstParam->nBitmap = pstParam->nBitmap & pstDev->nFullSBitmapPerVPg;
-
-    FSR_ASSERT(nLpn >= (UINT32)(((pstLogGrp->pstFm->nDgn    ) << pstZone->pstRI->nNShift) << pstDev->nPagesPerSbShift));
-    FSR_ASSERT(nLpn <  (UINT32)(((pstLogGrp->pstFm->nDgn + 1) << pstZone->pstRI->nNShift) << pstDev->nPagesPerSbShift));
-
-    FSR_STL_InitCRCs(pstZone, pstParam);
-
-    pstVFLParam = FSR_STL_AllocVFLParam(pstZone);
-
-    pstVFLParam->pExtParam = FSR_STL_AllocVFLExtParam(pstZone);
-    pstVFLParam->pExtParam->nNumExtSData = 0;
-    pstVFLParam->pExtParam->nNumRndIn = 0;
-
-    bBufferWrite = FSR_STL_DetermineBufferWrite(
-        pstZone, pstLog, pstParam, nTrTotalSize);
-
-#if (OP_SUPPORT_STATISTICS_INFO == 1)
-    if(bBufferWrite)
-    {
-        pstZone->pstStats->nBufferWriteCnt++;
-
-        if ((pstBUCtx->nBufState == STL_BUFSTATE_DIRTY) &&
-            (pstBUCtx->nBufferedLpn == nLpn))
-        {
-            pstZone->pstStats->nBufferHitCnt++;
-        }
-    }
-#endif
-
-    if(!bBufferWrite)
-    {
-        /* get clean page address of the log */
-        nDstVpn = FSR_STL_GetLogCPN(pstZone, pstLog, nLpn);
-
-        /* increase the clean page offset of the log */
-        pstLog->nCPOffs++;
-
-#if (OP_SUPPORT_MLC_LSB_ONLY == 1)
-        FSR_STL_CheckMLCFastMode(pstZone, pstLog);
-#endif
-    }
-    else if(bBufferWrite)
-    {
-        /* Context has to be stored if new unit is allocated */
-        nRet = FSR_STL_ReserveMetaPgs(pstZone, 1, TRUE32);
-        if (nRet != FSR_STL_SUCCESS)
-        {
-            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-            return nRet;
-        }
-        
-        /* We always confirm the buffer */
-        bConfirmPage = TRUE32;
-        
-        if (pstDev->nDeviceType == RBW_DEVTYPE_MLC)
-        {
-            /* When MLC case, we use only LSB pages. */
-            nBufNumMaxPgs = (POFFSET)(pstDev->nPagesPerSBlk >> 1);
-        }
-        else
-        {
-            nBufNumMaxPgs = (POFFSET)(pstDev->nPagesPerSBlk);
-        }
-
-#if (OP_SUPPORT_DATA_WEAR_LEVELING == 1)
-        if (pstBUCtx->nBBlkCPOffset >= nBufNumMaxPgs)
-        {
-            nRet = FSR_STL_WearLevelFreeBlk(pstZone, 1, NULL_DGN);
-            if (nRet != FSR_STL_SUCCESS)
-            {
-                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR,
-                    (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
-                        __FSR_FUNC__, __LINE__, nRet));
-                return nRet;
-            }
-        }
-#endif  /* (OP_SUPPORT_DATA_WEAR_LEVELING == 1) */
-    }
-
-
-/* 
- * Note: we don't have to initialize CRC field, since we guarantee
- * that CRC field has been initialized before here.
- */
-
-    if((!bBufferWrite) &&
-       (pstParam->nBitmap == pstDev->nFullSBitmapPerVPg))
-    {
-        /* set spare data 1, 2, 3 */
-        FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstParam, bConfirmPage);
-
-        if (bConfirmPage)
-        {
-            /* Initialize CRC */
-            FSR_STL_InitCRCs(pstZone, pstParam);
-            FSR_STL_ComputeCRCs(pstZone, NULL, pstParam, FALSE32);
-            pstParam->pExtParam->nNumExtSData = nNumExtSData;
-        }
-
-        nRet = FSR_STL_Convert_ExtParam(pstZone, pstParam);        
-        nRet = FSR_STL_FlashProgram(pstZone, nDstVpn, pstParam);
-        if ( nRet != FSR_BML_SUCCESS )
-        {
-            return nRet;
-        }
-    }
-    else
-    {
-        /*
-         *  flush the buffered page if
-         *  (1) we have to write the data into the buffer and
-         *  (2) the buffered data is dirty and 
-         *  (3) the buffered data is not conflict with the current one.
-         */
-
-        if (bBufferWrite &&
-                pstBUCtx->nBufState == STL_BUFSTATE_DIRTY && 
-                pstBUCtx->nBufferedLpn != nLpn)
-        {
-            nRet = FSR_STL_FlushBufferPage(pstZone);
-            if (nRet != FSR_STL_SUCCESS)
-            {
-                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                    (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-                return nRet;
-            }
-        }
-
-        /* Compute source pages and bitmaps */
-        nSrcVpn = NULL_VPN;
-        nSrcBitmap = 0;
-
-        /*
-         * 1. Src from the buffer
-         * Check for overwrite case
-         */
-        if ((pstBUCtx->nBufState    == STL_BUFSTATE_DIRTY) &&
-            (pstBUCtx->nBufferedLpn == nLpn))
-        {
-            nBufSrcBitmap = pstBUCtx->nValidSBitmap;
-            /* Clear bit map for sectors being overwritten */
-            nBufSrcBitmap = nBufSrcBitmap &(~pstParam->nBitmap);
-        }
-        else
-        {
-            nBufSrcBitmap = 0;
-        }
-        nBufSrcVpn = (nBufSrcBitmap == 0 ? NULL_VBN : pstBUCtx->nBufferedVpn);
-
-        /*
-         * 2. Src from log block or data block
-         *  2.1. Compute the resultant valid bitmap
-         */
-        nDstBitmap = nBufSrcBitmap | pstParam->nBitmap;
-        /* 2.2. Missing scts from start of the page should be copied from data or log block */
-        nLogSrcBitmap = FSR_STL_MarkSBitmap(nDstBitmap);
-
-        if (!bBufferWrite || nLogSrcBitmap)
-        {
-            /* 
-             * Some scts from the start of page are missing 
-             * Thus, we have read it first
-             * find out the old source VPN
-             */
-            nRet = FSR_STL_GetLpn2Vpn(pstZone, nLpn, &nLogSrcVpn, &bPageDeleted);
-            if (nRet != FSR_STL_SUCCESS)
-            {
-                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                    (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-                return nRet;
-            }
-
-            if (!bPageDeleted)
-            {
-                if(bBufferWrite)
-                {
-                    ;/* nLogSrcBitmap = FSR_STL_MarkZeroUntilLastOneofSBitmap(nDstBitmap); */
-                }
-                else
-                {
-                    nLogSrcBitmap = (~nDstBitmap) & pstDev->nFullSBitmapPerVPg;
-                }
-
-                nDstBitmap = nDstBitmap | nLogSrcBitmap;
-            }
-            else
-            {
-                nLogSrcBitmap = 0;
-                nLogSrcVpn = NULL_VPN;
-            }
-        }
-
-        /*
-         * Prepare data 
-         * The 1st case is where data from previous buffer and log or data block should be merged
-         */
-        if (nLogSrcBitmap && nBufSrcBitmap)
-        {
-            /*
-             * Since we guarantee that a buffered sectors are contiguous and start from 
-             * the first sector of the page,
-             * there is only one possible layout as belows.
-             *             _________________
-             *             |   |   |   |   |
-             *             -----------------
-             *     src f/  -->          <--- src f/ log
-             *       buf            
-             *  (1) When the new dat overlaps with the src from the buffer
-             *      - Buffer write && NO SRC FROM LOG --> contradiction
-             *  (2) Whe the new data overlaps with the log src
-             *      - (1) end-full case --> log write
-             *      - (2) otherwise --> buffer write && new data wrapped by log src
-             */
-
-            pstVFLParam->bPgSizeBuf = TRUE32;
-            pstVFLParam->bUserData = FALSE32;
-            pstVFLParam->bSpare = TRUE32;
-
-            FSR_STL_InitCRCs(pstZone, pstVFLParam);
-            pstVFLParam->pExtParam->nNumExtSData = nNumExtSData;
-
-            pstVFLParam->nBitmap = nLogSrcBitmap;
-            pstVFLParam->nNumOfPgs = 1;
-            pstVFLParam->pData     = (UINT8 *)(pstZone->pTempMetaPgBuf);
-
-            nRet = FSR_STL_FlashRead(pstZone, nLogSrcVpn, pstVFLParam, FALSE32);
-            if (nRet != FSR_BML_SUCCESS)
-            {
-                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                    (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-                return nRet;
-            }
-
-            if (IS_LOG_CRC_VALID(pstVFLParam->nSData3 >> 16))
-            { 
-                bCRCValid = TRUE32;
-            }
-
-            pCurDataPos = pstParam->pData;
-            pCurBufPos   = (UINT8 *)(pstZone->pTempMetaPgBuf);
-            bStartCopied = FALSE32;
-
-            for (nIdx = 0; nIdx < nSctPerVPg; nIdx++)
-            {
-                pnCurSrcCrc = &pstVFLParam->pExtParam->aExtSData[nIdx];
-                pnCurDstCRC = &pstParam->pExtParam->aExtSData[nIdx];
-
-                if ((pstParam->nBitmap) &(1 << nIdx))
-                {
-                    FSR_OAM_MEMCPY(pCurBufPos, pCurDataPos, BYTES_PER_SECTOR);
-                    bStartCopied = TRUE32;
-                }
-                /* We reclaim pre-computed CRC value at best-effort */
-                else if ((nLogSrcBitmap & (1 << nIdx)) &&
-                         (bCRCValid))
-                {
-                    *pnCurDstCRC = *pnCurSrcCrc;
-                }
-
-                if (pstParam->bPgSizeBuf || bStartCopied)
-                {
-                    pCurDataPos += BYTES_PER_SECTOR;
-                }
-                pCurBufPos += BYTES_PER_SECTOR;
-            }
-
-            nSrcBitmap = nBufSrcBitmap;
-            nSrcVpn = nBufSrcVpn;
-
-            pstParam->nBitmap = pstParam->nBitmap | nLogSrcBitmap;
-            pstParam->pData      = (UINT8 *)(pstZone->pTempMetaPgBuf);
-            pstParam->bPgSizeBuf = TRUE32;
-        }
-        else if (nLogSrcBitmap && !nBufSrcBitmap)
-        {
-            nSrcVpn = nLogSrcVpn;
-            nSrcBitmap = nLogSrcBitmap;
-        }
-        else if (!nLogSrcBitmap && nBufSrcBitmap)
-        {
-            nSrcVpn = nBufSrcVpn;
-            nSrcBitmap = nBufSrcBitmap;
-        }
-        else
-        {
-            nSrcVpn = NULL_VPN;
-            nSrcBitmap = 0;
-        }
-
-        if(bBufferWrite)
-        {
-            /*
-             * When current clean page offset equals zero, we need to prepare empty buffer block.
-             * The new buffer block is obtained from free list
-             * NOTE: the context has to be stored after the current buffer page has been written completely.
-             */
-            if (pstBUCtx->nBBlkCPOffset >= nBufNumMaxPgs)
-            {
-                FSR_ASSERT(pstCtxFm->nBBlkVbn != NULL_VBN);
-
-                /* Swap VBNs & ECs */
-                nBBlkVbn = pstCtx->pFreeList[pstCtxFm->nFreeListHead];
-                nBBlkEC  = pstCtx->pFBlksEC [pstCtxFm->nFreeListHead] + 1;
-
-                pstCtx->pFreeList[pstCtxFm->nFreeListHead] = pstCtxFm->nBBlkVbn;
-                pstCtx->pFBlksEC [pstCtxFm->nFreeListHead] = pstCtxFm->nBBlkEC;
-
-                pstCtxFm->nBBlkVbn = nBBlkVbn;
-                pstCtxFm->nBBlkEC  = nBBlkEC;
-
-                /* Get buffer blocks' VBN */
-                nRet = FSR_STL_FlashErase(pstZone, nBBlkVbn);
-                if (nRet != FSR_BML_SUCCESS)
-                {
-                    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-                    return nRet;
-                }
-
-                FSR_ASSERT(nBBlkVbn != NULL_VBN);
-
-                pstBUCtx->nBBlkCPOffset = 0;
-            }
-            else
-            {
-                /* Get buffer blocks' VBN */
-                nBBlkVbn = pstCtxFm->nBBlkVbn;
-                FSR_ASSERT(nBBlkVbn != NULL_VBN);
-            }
-
-            /*
-             * Destination address : inside of buffer block
-             * VPN to write the context
-             */
-            if (pstDev->nDeviceType == RBW_DEVTYPE_MLC)
-            {
-                nDstVpn = (nBBlkVbn << pstDev->nPagesPerSbShift)
-                              + FSR_BML_GetVPgOffOfLSBPg(pstZone->nVolID, pstBUCtx->nBBlkCPOffset);
-            }
-            else
-            {
-                nDstVpn = (nBBlkVbn << pstDev->nPagesPerSbShift)
-                        + pstBUCtx->nBBlkCPOffset;
-            }
-
-            pstParam->bUserData = FALSE32;
-            pstParam->bSpare = TRUE32;
-
-            /*
-             * Prepare spare data
-             * First, fIll SData1 ~ SData2 as follows
-             *      SData1: LPN
-             *      SData2: ~LPN
-             *      SData3: PTF.~PTF
-             */
-            pstParam->nSData1 = nLpn;
-            pstParam->nSData2 = ~nLpn;
-
-            /* Fill PTF into SData3 */
-            pstParam->nSData3 = FSR_STL_SetPTF(pstZone, TF_BU, 0, 0,
-                                    sizeof(SBITMAP) * 8 - (UINT8)FSR_STL_GetZBC((UINT8 *)( &nDstBitmap), sizeof(SBITMAP)));
-            pstParam->nSData3 = (pstParam->nSData3 << 16) | (0xffff & (~pstParam->nSData3));
-        }
-        else
-        {
-            if(nBufSrcBitmap)
-            {
-                bConfirmPage = TRUE32;
-            }
-            /* set spare data 1, 2, 3 */
-            FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstParam, bConfirmPage); 
-        }
-
-        
-        /* If the target page is deleted, there is no valid data in that logical page.*/
-        if ((nSrcBitmap == 0) ||
-            (nSrcVpn    == NULL_VPN))
-        {
-            /* Buffer is filled solely by the source data */
-            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                (TEXT("VFL_Program : nLpn = %d, nDstVpn = %d(%d)\n"), nLpn, nDstVpn, GET_REMAINDER(nDstVpn, pstDev->
-                nPagesPerSbShift) ));
-
-            if(bConfirmPage)
-            {
-                FSR_STL_ComputeCRCs(pstZone, NULL, pstParam, FALSE32);
-                pstParam->pExtParam->nNumExtSData = nNumExtSData;
-            }
-
-            nRet = FSR_STL_Convert_ExtParam(pstZone, pstParam);
-            nRet = FSR_STL_FlashProgram(pstZone, nDstVpn, pstParam);
-        }
-        else
-        {
-            /* Buffer has to be filled by the temporal buffer */
-            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                (TEXT("VFL_Copyback : nLpn = %d, nSrcVpn = %d, nDstVbn = %d, nDstVpn = %d(%d)\n"), nLpn, nSrcVpn, nDstVpn
-                / pstDev->nPagesPerSBlk, nDstVpn, GET_REMAINDER(nDstVpn, pstDev->nPagesPerSbShift) ));
-
-            if(bConfirmPage)
-            {
-                nRet = FSR_STL_FlashModiCopybackCRC(pstZone, nSrcVpn, nDstVpn, pstParam);
-            }
-            else
-            {        
-                nRet = FSR_STL_Convert_ExtParam(pstZone, pstParam);
-        
-                nRet = FSR_STL_FlashModiCopyback(pstZone, nSrcVpn, nDstVpn, pstParam);
-            }
-        }
-
-        if (nRet != FSR_BML_SUCCESS)
-        {
-            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-            return nRet;
-        }
-
-        if(bBufferWrite)
-        {
-            /* Update state */
-            pstBUCtx->nBufferedLpn = nLpn;
-            pstBUCtx->nBufState = STL_BUFSTATE_DIRTY;
-            pstBUCtx->nBufferedDgn = pstLogGrp->pstFm->nDgn;
-            pstBUCtx->nBufferedVpn = nDstVpn;
-            pstBUCtx->nValidSBitmap = nDstBitmap;
-
-            /* Store context info */
-            nRet = FSR_STL_StoreBMTCtx(pstZone, FALSE32);
-            if (nRet != FSR_STL_SUCCESS)
-            {
-                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-                    (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-                return nRet;
-            }
-
-            /* Move clean page offset */
-            pstBUCtx->nBBlkCPOffset++;
-        }
-        else if (nLpn == pstZone->pstBUCtxObj->nBufferedLpn)
-        {
-            STL_BUFFER_CTX_AFTER_FLUSH(pstZone->pstBUCtxObj);
-        }
-    }
-
-#if (OP_SUPPORT_STATISTICS_INFO == 1)
-    if(!bBufferWrite && nBufSrcBitmap) 
-    {
-        pstZone->pstStats->nBufferHitCnt++;
-    }
-#endif
-
-    if(!bBufferWrite)
-    {
-        /* log group PMT update */
-        FSR_STL_UpdatePMT(pstZone, pstLogGrp, pstLog, nLpn, nDstVpn);
-
-        /* change the state of log block */
-        FSR_STL_ChangeLogState(pstZone, pstLogGrp, pstLog, nLpn);
-
-#if (OP_SUPPORT_STATISTICS_INFO == 1)
-        pstZone->pstStats->nTotalLogPgmCnt++;
-#endif  /* (OP_SUPPORT_STATISTICS_INFO == 1) */
-    }
-
-    FSR_STL_FreeVFLExtParam(pstZone, pstVFLParam->pExtParam);
-
-    FSR_STL_FreeVFLParam(pstZone, pstVFLParam);
-
-    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
-        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
-    return FSR_STL_SUCCESS;
-}
-
-#endif  /* (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1) */
+/**
+ *   @mainpage   Flex Sector Remapper
+ *
+ *   @section Intro
+ *       Flash Translation Layer for Flex-OneNAND and OneNAND
+ *    
+ *    @section  Copyright
+ *            COPYRIGHT. 2007-2009 SAMSUNG ELECTRONICS CO., LTD.               
+ *                            ALL RIGHTS RESERVED                              
+ *                                                                             
+ *     Permission is hereby granted to licensees of Samsung Electronics        
+ *     Co., Ltd. products to use or abstract this computer program for the     
+ *     sole purpose of implementing a product based on Samsung                 
+ *     Electronics Co., Ltd. products. No other rights to reproduce, use,      
+ *     or disseminate this computer program, whether in part or in whole,      
+ *     are granted.                                                            
+ *                                                                             
+ *     Samsung Electronics Co., Ltd. makes no representation or warranties     
+ *     with respect to the performance of this computer program, and           
+ *     specifically disclaims any responsibility for any damages,              
+ *     special or consequential, connected with the use of this program.       
+ *
+ *     @section Description
+ *
+ */
+
+/** 
+ *  @file       FSR_STL_BufferBlkMgr.c
+ *  @brief      This file contains buffer block related codes.
+ *  @author     Wonmoon Cheon
+ *  @date       23-MAY-2007
+ *  @remark
+ *  REVISION HISTORY
+ *  @n  23-MAY-2007 [Wonmoon Cheon] : first writing
+ *  @n  29-JAN-2008 [MinYoung Kim] : dead code elimination
+ *
+ */
+
+/*****************************************************************************/
+/* Header file inclusions                                                    */
+/*****************************************************************************/
+#include "FSR.h"
+
+#include "FSR_STL_CommonType.h"
+#include "FSR_STL_Config.h"
+#include "FSR_STL_Interface.h"
+#include "FSR_STL_Types.h"
+#include "FSR_STL_Common.h"
+
+/*****************************************************************************/
+/* Global variable definitions                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Imported variable declarations                                            */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Imported function prototype                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Local macro                                                               */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Local type defines                                                        */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Local constant definitions                                                */
+/*****************************************************************************/
+
+/*****************************************************************************/
+/* Local (static) function prototype                                         */
+/*****************************************************************************/
+#if (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1)
+PRIVATE POFFSET     _GetBufferMaxPgs       (STLZoneObj     *pstZone);
+PRIVATE UINT32      _GetNumOfDirtySlots    (STLBUCtxObj    *pstBUCtx);
+PRIVATE STLBUSlot*  _SelectBufferSlot      (STLBUCtxObj    *pstBUCtx);
+PRIVATE INT32       _WriteBufferRelease    (STLZoneObj     *pstZone,
+                                            PADDR           nLpn);
+PRIVATE INT32       _PrepareBufferSlot     (STLZoneObj     *pstZone,
+                                            PADDR           nLpn);
+#endif  /* (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1) */
+
+/*****************************************************************************/
+/* Local (static)  Function Definition                                       */
+/*****************************************************************************/
+
+#if (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1)
+
+/**
+ * @brief       This function returns the number of pages in a buffer block.
+ *
+ * @param[in]   pstZone     : zone object
+ *
+ * @return      the number of pages to write in a buffer block
+ *
+ */
+PRIVATE POFFSET
+_GetBufferMaxPgs   (STLZoneObj     *pstZone)
+{
+    const   RBWDevInfo *pstDev  = pstZone->pstDevInfo;
+
+    if (pstDev->nDeviceType == RBW_DEVTYPE_MLC)
+    {
+        /* When MLC case, we use only LSB pages. */
+        return (POFFSET)(pstDev->nPagesPerSBlk >> 1);
+    }
+
+    return (POFFSET)(pstDev->nPagesPerSBlk);
+}
+
+/**
+ * @brief       This function returns the number of dirty buffer slots.
+ *
+ * @param[in]   pstBUCtx    : BU context object
+ *
+ * @return      the number of dirty buffer slots
+ *
+ */
+PRIVATE UINT32
+_GetNumOfDirtySlots    (STLBUCtxObj    *pstBUCtx)
+{
+    UINT32          nIdx;
+    UINT32          nCnt = 0;
+
+    for (nIdx = 0; nIdx < NUM_BU_SLOTS; nIdx++)
+    {
+        if (pstBUCtx->astSlot[nIdx].nBufState != STL_BUFSTATE_CLEAN)
+        {
+            nCnt++;
+        }
+    }
+
+    return nCnt;
+}
+
+/**
+ * @brief       This function selects the slot for a new buffered page.
+ * @n           A clean slot is used first. If all slots are dirty, the least
+ * @n           recently written slot is selected.
+ * @n           The same rule is used when the buffer block is scanned at the
+ * @n           open time, so that the scan rebuilds the same slots.
+ *
+ * @param[in]   pstBUCtx    : BU context object
+ *
+ * @return      pointer to the selected slot
+ *
+ */
+PRIVATE STLBUSlot*
+_SelectBufferSlot  (STLBUCtxObj    *pstBUCtx)
+{
+    STLBUSlot      *pstSlot;
+    STLBUSlot      *pstVictim;
+    UINT32          nIdx;
+
+    pstVictim = &(pstBUCtx->astSlot[0]);
+
+    for (nIdx = 0; nIdx < NUM_BU_SLOTS; nIdx++)
+    {
+        pstSlot = &(pstBUCtx->astSlot[nIdx]);
+
+        if (pstSlot->nBufState == STL_BUFSTATE_CLEAN)
+        {
+            return pstSlot;
+        }
+
+        if ((INT32)(pstSlot->nLRUStamp - pstVictim->nLRUStamp) < 0)
+        {
+            pstVictim = pstSlot;
+        }
+    }
+
+    return pstVictim;
+}
+
+/**
+ * @brief       This function writes a release page of nLpn into buffer block.
+ * @n           The release page has no valid sector. It tells the scan at
+ * @n           the open time that the page of nLpn has left the buffer.
+ * @n           The release page of NULL_VPN releases all buffered pages.
+ *
+ * @param[in]   pstZone     : zone object
+ * @param[in]   nLpn        : LPN of the page which has been flushed
+ *
+ * @return      FSR_STL_SUCCESS
+ *
+ */
+PRIVATE INT32
+_WriteBufferRelease    (STLZoneObj     *pstZone,
+                        PADDR           nLpn)
+{
+    const   RBWDevInfo *pstDev      = pstZone->pstDevInfo;
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    VFLParam       *pstVFLParam;
+    PADDR           nDstVpn;
+    const   UINT16  nSctPerVPg      = (UINT16)(pstDev->nSecPerVPg);
+    UINT16          nNumExtSData;
+    INT32           nRet;
+
+    FSR_STACK_VAR;
+    FSR_STACK_END;
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:IN ]  ++%s(nLpn:%d)\r\n"), __FSR_FUNC__, nLpn));
+
+    FSR_ASSERT(pstBUCtx->nBBlkCPOffset < _GetBufferMaxPgs(pstZone));
+    FSR_ASSERT(pstZone->pstCtxHdl->pstFm->nBBlkVbn != NULL_VBN);
+
+    nNumExtSData = (nSctPerVPg == STL_2KB_PG) ? nSctPerVPg >> 1 : nSctPerVPg;
+
+    if (pstDev->nDeviceType == RBW_DEVTYPE_MLC)
+    {
+        nDstVpn = (pstZone->pstCtxHdl->pstFm->nBBlkVbn << pstDev->nPagesPerSbShift)
+                + FSR_BML_GetVPgOffOfLSBPg(pstZone->nVolID, pstBUCtx->nBBlkCPOffset);
+    }
+    else
+    {
+        nDstVpn = (pstZone->pstCtxHdl->pstFm->nBBlkVbn << pstDev->nPagesPerSbShift)
+                + pstBUCtx->nBBlkCPOffset;
+    }
+
+    pstVFLParam = FSR_STL_AllocVFLParam(pstZone);
+    pstVFLParam->pExtParam = FSR_STL_AllocVFLExtParam(pstZone);
+
+    FSR_OAM_MEMSET(pstZone->pTempMetaPgBuf, 0xFF, nSctPerVPg << BYTES_SECTOR_SHIFT);
+
+    pstVFLParam->bPgSizeBuf = TRUE32;
+    pstVFLParam->bUserData  = FALSE32;
+    pstVFLParam->bSpare     = TRUE32;
+    pstVFLParam->nBitmap    = pstDev->nFullSBitmapPerVPg;
+    pstVFLParam->nNumOfPgs  = 1;
+    pstVFLParam->pData      = (UINT8 *)(pstZone->pTempMetaPgBuf);
+
+    /* No valid sector : the buffered page of nLpn is released */
+    pstVFLParam->nSData1    = nLpn;
+    pstVFLParam->nSData2    = ~nLpn;
+    pstVFLParam->nSData3    = FSR_STL_SetPTF(pstZone, TF_BU, 0, 0, 0);
+    pstVFLParam->nSData3    = (pstVFLParam->nSData3 << 16) | (0xffff & (~pstVFLParam->nSData3));
+
+    FSR_STL_InitCRCs(pstZone, pstVFLParam);
+    FSR_STL_ComputeCRCs(pstZone, NULL, pstVFLParam, FALSE32);
+    pstVFLParam->pExtParam->nNumExtSData = nNumExtSData;
+
+    nRet = FSR_STL_Convert_ExtParam(pstZone, pstVFLParam);
+    if (nRet == FSR_STL_SUCCESS)
+    {
+        nRet = FSR_STL_FlashProgram(pstZone, nDstVpn, pstVFLParam);
+    }
+
+    FSR_STL_FreeVFLExtParam(pstZone, pstVFLParam->pExtParam);
+    FSR_STL_FreeVFLParam(pstZone, pstVFLParam);
+
+    if (nRet != FSR_BML_SUCCESS)
+    {
+        FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+            (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+        return nRet;
+    }
+
+    /* Move clean page offset */
+    pstBUCtx->nBBlkCPOffset++;
+
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:OUT]  --%s()\r\n"), __FSR_FUNC__));
+    return FSR_STL_SUCCESS;
+}
+
+/**
+ * @brief       This function makes room for nLpn in the buffer unit.
+ * @n           If nLpn is not buffered and all slots are dirty, 
+ * @n           the least recently written page is flushed into log block.
+ * @n           The buffer block always keeps one clean page for the release
+ * @n           of each buffered page. If there is no room for the page of
+ * @n           nLpn, all buffered pages are flushed.
+ *
+ * @param[in]   pstZone     : zone object
+ * @param[in]   nLpn        : LPN to write into buffer block
+ *
+ * @return      FSR_STL_SUCCESS
+ *
+ */
+PRIVATE INT32
+_PrepareBufferSlot (STLZoneObj     *pstZone,
+                    PADDR           nLpn)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    STLBUSlot      *pstSlot;
+    PADDR           nVictimLpn;
+    UINT32          nNumOfDirty;
+    const   POFFSET nBufNumMaxPgs   = _GetBufferMaxPgs(pstZone);
+    INT32           nRet            = FSR_STL_SUCCESS;
+
+    FSR_STACK_VAR;
+    FSR_STACK_END;
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:IN ]  ++%s(nLpn:%d)\r\n"), __FSR_FUNC__, nLpn));
+
+    pstSlot = FSR_STL_SearchBufferSlot(pstZone, nLpn);
+    if (pstSlot == NULL)
+    {
+        pstSlot = _SelectBufferSlot(pstBUCtx);
+        if (pstSlot->nBufState != STL_BUFSTATE_CLEAN)
+        {
+            /* Evict the least recently written page */
+            nVictimLpn = pstSlot->nBufferedLpn;
+
+            nRet = FSR_STL_FlushBufferSlot(pstZone, pstSlot);
+            if (nRet != FSR_STL_SUCCESS)
+            {
+                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                    (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+                return nRet;
+            }
+
+            /*
+             * The scan at the open time evicts the same page by itself
+             * when the next buffer page is written into a full buffer.
+             * If some other pages have left the buffer during the flush,
+             * the buffer is not full any more. Then the eviction is recorded.
+             */
+            if (_GetNumOfDirtySlots(pstBUCtx) != (NUM_BU_SLOTS - 1))
+            {
+                nRet = _WriteBufferRelease(pstZone, nVictimLpn);
+                if (nRet != FSR_STL_SUCCESS)
+                {
+                    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+                    return nRet;
+                }
+            }
+        }
+    }
+
+    /* The number of buffered pages after the page of nLpn is written */
+    nNumOfDirty = _GetNumOfDirtySlots(pstBUCtx);
+    if (FSR_STL_SearchBufferSlot(pstZone, nLpn) == NULL)
+    {
+        nNumOfDirty++;
+    }
+
+    /* The buffered pages cannot move to a new buffer block */
+    if ((pstBUCtx->nBBlkCPOffset + 1 + nNumOfDirty) > nBufNumMaxPgs)
+    {
+        nRet = FSR_STL_FlushBufferPage(pstZone);
+    }
+
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+    return nRet;
+}
+
+#endif  /* (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1) */
+
+/*****************************************************************************/
+/* Global Function Definition                                                */
+/*****************************************************************************/
+
+#if (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1)
+
+/**
+ * @brief       This function searches the dirty buffer slot of nLpn.
+ *
+ * @param[in]   pstZone     : zone object
+ * @param[in]   nLpn        : LPN to search
+ *
+ * @return      pointer to the buffer slot, NULL if nLpn is not buffered
+ *
+ */
+PUBLIC STLBUSlot*
+FSR_STL_SearchBufferSlot   (STLZoneObj     *pstZone,
+                            PADDR           nLpn)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    STLBUSlot      *pstSlot;
+    UINT32          nIdx;
+
+    for (nIdx = 0; nIdx < NUM_BU_SLOTS; nIdx++)
+    {
+        pstSlot = &(pstBUCtx->astSlot[nIdx]);
+
+        if ((pstSlot->nBufState    != STL_BUFSTATE_CLEAN) &&
+            (pstSlot->nBufferedLpn == nLpn))
+        {
+            return pstSlot;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief       This function searches a dirty buffer slot in nDgn.
+ *
+ * @param[in]   pstZone     : zone object
+ * @param[in]   nDgn        : data group number to search
+ *
+ * @return      pointer to the buffer slot, NULL if no page of nDgn is buffered
+ *
+ */
+PUBLIC STLBUSlot*
+FSR_STL_SearchBufferDgn    (STLZoneObj     *pstZone,
+                            BADDR           nDgn)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    STLBUSlot      *pstSlot;
+    UINT32          nIdx;
+
+    for (nIdx = 0; nIdx < NUM_BU_SLOTS; nIdx++)
+    {
+        pstSlot = &(pstBUCtx->astSlot[nIdx]);
+
+        if ((pstSlot->nBufState    != STL_BUFSTATE_CLEAN) &&
+            (pstSlot->nBufferedDgn == nDgn))
+        {
+            return pstSlot;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief       This function returns the lowest buffered LPN in the range.
+ *
+ * @param[in]   pstZone     : zone object
+ * @param[in]   nStartLpn   : the first LPN of the range
+ * @param[in]   nEndLpn     : the last LPN of the range
+ *
+ * @return      the lowest buffered LPN, NULL_VPN if no page is buffered
+ *
+ */
+PUBLIC PADDR
+FSR_STL_GetBufferedLpn     (STLZoneObj     *pstZone,
+                            PADDR           nStartLpn,
+                            PADDR           nEndLpn)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    STLBUSlot      *pstSlot;
+    PADDR           nLpn            = NULL_VPN;
+    UINT32          nIdx;
+
+    for (nIdx = 0; nIdx < NUM_BU_SLOTS; nIdx++)
+    {
+        pstSlot = &(pstBUCtx->astSlot[nIdx]);
+
+        if ((pstSlot->nBufState    != STL_BUFSTATE_CLEAN) &&
+            (pstSlot->nBufferedLpn >= nStartLpn) &&
+            (pstSlot->nBufferedLpn <= nEndLpn) &&
+            (pstSlot->nBufferedLpn <  nLpn))
+        {
+            nLpn = pstSlot->nBufferedLpn;
+        }
+    }
+
+    return nLpn;
+}
+
+/**
+ * @brief       This function checks whether any page is buffered or not.
+ *
+ * @param[in]   pstZone     : zone object
+ *
+ * @return      TRUE32  : some pages are buffered
+ * @return      FALSE32 : the buffer is clean
+ *
+ */
+PUBLIC BOOL32
+FSR_STL_IsBufferDirty      (STLZoneObj     *pstZone)
+{
+    return (_GetNumOfDirtySlots(pstZone->pstBUCtxObj) != 0) ? TRUE32 : FALSE32;
+}
+
+/**
+ * @brief       This function stores a page written into buffer block in a slot.
+ * @n           If nLpn is not buffered, a clean slot or the least recently
+ * @n           written slot is used.
+ *
+ * @param[in]   pstZone     : zone object
+ * @param[in]   nLpn        : LPN of the buffered page
+ * @param[in]   nVpn        : VPN of the buffered page in buffer block
+ * @param[in]   nBitmap     : valid sector bitmap of the buffered page
+ *
+ * @return      pointer to the buffer slot
+ *
+ */
+PUBLIC STLBUSlot*
+FSR_STL_SetBufferSlot      (STLZoneObj     *pstZone,
+                            PADDR           nLpn,
+                            PADDR           nVpn,
+                            SBITMAP         nBitmap)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    STLBUSlot      *pstSlot;
+
+    pstSlot = FSR_STL_SearchBufferSlot(pstZone, nLpn);
+    if (pstSlot == NULL)
+    {
+        pstSlot = _SelectBufferSlot(pstBUCtx);
+    }
+
+    pstSlot->nBufState      = STL_BUFSTATE_DIRTY;
+    pstSlot->nBufferedLpn   = nLpn;
+    pstSlot->nBufferedDgn   = (BADDR)((nLpn >> pstZone->pstDevInfo->nPagesPerSbShift)
+                                            >> pstZone->pstRI->nNShift);
+    pstSlot->nBufferedVpn   = nVpn;
+    pstSlot->nValidSBitmap  = nBitmap;
+    pstSlot->nLRUStamp      = ++(pstBUCtx->nLRUClock);
+
+    return pstSlot;
+}
+
+/**
+ * @brief       This function invalidates all buffered pages.
+ *
+ * @param[in]   pstZone     : zone object
+ *
+ * @return      none
+ *
+ */
+PUBLIC VOID
+FSR_STL_InvalidateBuffer   (STLZoneObj     *pstZone)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    UINT32          nIdx;
+
+    for (nIdx = 0; nIdx < NUM_BU_SLOTS; nIdx++)
+    {
+        STL_BUFFER_CTX_AFTER_INVALIDATE(&(pstBUCtx->astSlot[nIdx]));
+    }
+}
+
+/**
+ * @brief       This function writes all buffered pages into log block.
+ * @n           The release of all pages is recorded in buffer block.
+ *
+ * @param[in]   pstZone                     : Zone object
+ *
+ * @return      FSR_STL_SUCCESS
+ *
+ * @author      Jaesoo Lee
+ * @version     1.1.0
+ */
+PUBLIC INT32 
+FSR_STL_FlushBufferPage    (STLZoneObj *pstZone)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    STLBUSlot      *pstSlot;
+    UINT32          nIdx;
+    BOOL32          bFlushed        = FALSE32;
+    INT32           nRet            = FSR_STL_SUCCESS;
+
+    FSR_STACK_VAR;
+    FSR_STACK_END;
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:IN ]  ++%s()\r\n"), __FSR_FUNC__));
+
+    for (nIdx = 0; nIdx < NUM_BU_SLOTS; nIdx++)
+    {
+        pstSlot = &(pstBUCtx->astSlot[nIdx]);
+
+        /* The slot can be flushed by a merge during the previous flush */
+        if (pstSlot->nBufState == STL_BUFSTATE_CLEAN)
+        {
+            continue;
+        }
+
+        nRet = FSR_STL_FlushBufferSlot(pstZone, pstSlot);
+        if (nRet != FSR_STL_SUCCESS)
+        {
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+            return nRet;
+        }
+
+        bFlushed = TRUE32;
+    }
+
+    /* The pages in buffer block are not valid any more */
+    if ((bFlushed == TRUE32) &&
+        (pstBUCtx->nBBlkCPOffset < _GetBufferMaxPgs(pstZone)))
+    {
+        nRet = _WriteBufferRelease(pstZone, NULL_VPN);
+    }
+
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+    return nRet;
+}
+
+/**
+ * @brief       This function writes the buffered pages of nDgn into log block.
+ * @n           The release of the flushed pages is recorded in buffer block.
+ *
+ * @param[in]   pstZone     : Zone object
+ * @param[in]   nDgn        : data group number to flush
+ *
+ * @return      FSR_STL_SUCCESS
+ *
+ */
+PUBLIC INT32 
+FSR_STL_FlushBufferDgn     (STLZoneObj     *pstZone,
+                            BADDR           nDgn)
+{
+    STLBUCtxObj    *pstBUCtx        = pstZone->pstBUCtxObj;
+    STLBUSlot      *pstSlot;
+    PADDR           naLpn[NUM_BU_SLOTS];
+    UINT32          nNumOfLpns      = 0;
+    UINT32          nIdx;
+    INT32           nRet            = FSR_STL_SUCCESS;
+
+    FSR_STACK_VAR;
+    FSR_STACK_END;
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:IN ]  ++%s(nDgn:%d)\r\n"), __FSR_FUNC__, nDgn));
+
+    while ((pstSlot = FSR_STL_SearchBufferDgn(pstZone, nDgn)) != NULL)
+    {
+        naLpn[nNumOfLpns++] = pstSlot->nBufferedLpn;
+
+        nRet = FSR_STL_FlushBufferSlot(pstZone, pstSlot);
+        if (nRet != FSR_STL_SUCCESS)
+        {
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+            return nRet;
+        }
+    }
+
+    /*
+     * There is always room for the release of the buffered pages.
+     * Only at the open time, the buffer block is full. 
+     * Then the buffer block is replaced after all pages are flushed.
+     */
+    if ((pstBUCtx->nBBlkCPOffset + nNumOfLpns) <= _GetBufferMaxPgs(pstZone))
+    {
+        for (nIdx = 0; nIdx < nNumOfLpns; nIdx++)
+        {
+            nRet = _WriteBufferRelease(pstZone, naLpn[nIdx]);
+            if (nRet != FSR_STL_SUCCESS)
+            {
+                break;
+            }
+        }
+    }
+
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+    return nRet;
+}
+
+/**
+ * @brief       This function writes a buffered page into log block.
+ *
+ * @param[in]   pstZone                     : Zone object
+ * @param[in]   pstSlot                     : buffer slot to flush
+ *
+ * @return      FSR_STL_SUCCESS
+ *
+ */
+PUBLIC INT32 
+FSR_STL_FlushBufferSlot    (STLZoneObj     *pstZone,
+                            STLBUSlot      *pstSlot)
+{
+    RBWDevInfo     *pstDev;
+    STLLogGrpHdl   *pstLogGrp       = NULL;
+    STLLog         *pstLog          = NULL;
+    PADDR           nLpn;
+    PADDR           nDstVpn;
+    PADDR           nSrcVpn;
+    SBITMAP         nValidSBitmap;
+    PADDR           nLogSrcVpn      = NULL_VPN;
+    SBITMAP         nLogSrcBitmap   = 0;
+    BOOL32          bPageDeleted    = FALSE32;
+    VFLParam       *pstVFLParam;
+    UINT16          nSctPerVPg      = (UINT16)pstZone->pstDevInfo->nSecPerVPg;
+    INT32           nRet            = FSR_STL_SUCCESS;
+    UINT16          nNumExtSData;
+
+    FSR_STACK_VAR;
+    FSR_STACK_END;
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:IN ]  ++%s()\r\n"), __FSR_FUNC__));
+
+    /* Get device info pointer */
+    pstDev = pstZone->pstDevInfo;
+
+    nNumExtSData = (nSctPerVPg == STL_2KB_PG) ? nSctPerVPg >> 1 : nSctPerVPg;
+
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_INF,
+        (TEXT("[SIF:INF] (nVolID:%d, nZoneID:%d, nBufferedLpn:%d, nValidSBitmap:%08b)\r\n"),
+            pstZone->nVolID, pstZone->nZoneID, pstSlot->nBufferedLpn, pstSlot->nValidSBitmap));
+
+#if (OP_SUPPORT_RUNTIME_PMT_BUILDING == 1)
+    /* Execute Run time scanning */
+    nRet = FSR_STL_ScanActLogBlock(pstZone,pstSlot->nBufferedDgn);
+    if (nRet != FSR_STL_SUCCESS)
+    {
+        FSR_DBZ_RTLMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR, 
+            (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
+            __FSR_FUNC__, __LINE__, nRet));
+        return nRet;
+    }
+#endif /*OP_SUPPORT_RUNTIME_PMT_BUILDING*/
+
+    if (pstSlot->nBufState == STL_BUFSTATE_CLEAN)
+    {
+        FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+            (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+        return nRet;
+    }
+
+    FSR_ASSERT(pstSlot->nBufferedLpn != NULL_VPN);
+
+    /* LPN to write */
+    nLpn          = pstSlot->nBufferedLpn;
+    nSrcVpn       = pstSlot->nBufferedVpn;
+    nValidSBitmap = pstSlot->nValidSBitmap;
+
+    /*
+     * In order to avoid deadlock, we change the buf state a priori.
+     * Change the buffer state to CLEAN
+     */
+    STL_BUFFER_CTX_AFTER_FLUSH(pstSlot);
+
+    /*
+     * Before we flush the buffered page into log block, we need an active log
+     * to flush it. 
+     */
+
+    pstLogGrp = FSR_STL_PrepareActLGrp(pstZone, nLpn);
+    if (pstLogGrp == NULL)
+    {
+        FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR,
+            (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
+                __FSR_FUNC__, __LINE__, FSR_STL_ERR_NEW_LOGGRP));
+        return FSR_STL_ERR_NEW_LOGGRP;
+    }
+
+    nRet = FSR_STL_GetLogToWrite(pstZone, nLpn, pstLogGrp, &pstLog, NULL);
+    if (nRet != FSR_STL_SUCCESS)
+    {
+        FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR,
+            (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
+                __FSR_FUNC__, __LINE__, nRet));
+        return nRet;
+    }
+    /* Get clean page address of the log */
+    nDstVpn = FSR_STL_GetLogCPN(pstZone, pstLog, nLpn);
+
+    /* Increase the clean page offset of the log */
+    pstLog->nCPOffs++;
+
+#if (OP_SUPPORT_MLC_LSB_ONLY == 1)
+    /*
+     * For MLC LSB only mode, we moves the clean page offset according to the
+     * LSB/MSB page address scramble.
+     */
+
+    FSR_STL_CheckMLCFastMode(pstZone, pstLog);
+#endif  /* (OP_SUPPORT_MLC_LSB_ONLY == 1) */
+
+    if (nValidSBitmap != pstDev->nFullSBitmapPerVPg)
+    {
+        /*
+         * Some scts from the end of page are missing 
+         * find out the old source VPN
+         */
+         
+        nRet = FSR_STL_GetLpn2Vpn(pstZone, nLpn, &nLogSrcVpn, &bPageDeleted);
+
+        if (nRet != FSR_STL_SUCCESS)
+        {
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+            return nRet;
+        }
+
+        if (!bPageDeleted)
+        {
+            nLogSrcBitmap = pstDev->nFullSBitmapPerVPg & ~(nValidSBitmap);
+        }
+        else
+        {
+            nLogSrcBitmap = 0;
+        }
+    }
+
+    /* Initialize VFL params */
+    pstVFLParam = FSR_STL_AllocVFLParam(pstZone);
+    pstVFLParam->bPgSizeBuf = FALSE32;
+    pstVFLParam->bUserData  = FALSE32;
+    pstVFLParam->bSpare     = TRUE32;
+    pstVFLParam->nNumOfPgs  = 1;
+    pstVFLParam->pData      = (UINT8 *)pstZone->pTempMetaPgBuf;
+    pstVFLParam->pExtParam  = FSR_STL_AllocVFLExtParam(pstZone);
+
+    FSR_STL_InitCRCs(pstZone, pstVFLParam);
+    pstVFLParam->pExtParam->nNumExtSData = nNumExtSData;
+
+    do
+    {
+        if (!nLogSrcBitmap)
+        {
+            pstVFLParam->nBitmap = 0;
+
+            FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstVFLParam, TRUE32);
+
+            nRet = FSR_STL_Convert_ExtParam(pstZone, pstVFLParam);
+            if (nRet != FSR_STL_SUCCESS)
+            {
+                break;
+            }
+
+            nRet = FSR_STL_FlashModiCopybackCRC(pstZone, nSrcVpn, nDstVpn, pstVFLParam);
+            if (nRet != FSR_BML_SUCCESS)
+            {
+                break;
+            }
+        }
+        else
+        {
+            /* Note that buffered data is always the most recent */
+            pstVFLParam->nBitmap   = nValidSBitmap;
+            pstVFLParam->bUserData = FALSE32;
+
+            nRet = FSR_STL_FlashRead(pstZone, nSrcVpn, pstVFLParam, FALSE32);
+            if (nRet != FSR_BML_SUCCESS)
+            {
+                break;
+            }
+
+            /* We guarantee that the CRC in buffer is always valid*/
+            FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstVFLParam, TRUE32);
+
+            nRet = FSR_STL_Convert_ExtParam(pstZone, pstVFLParam);
+            if (nRet != FSR_STL_SUCCESS)
+            {
+                break;
+            }
+
+            nRet = FSR_STL_FlashModiCopybackCRC(pstZone, nLogSrcVpn, nDstVpn, pstVFLParam);
+            if (nRet != FSR_BML_SUCCESS)
+            {
+                break;
+            }
+        }
+
+        /* Update PMT of log group */
+        FSR_STL_UpdatePMT(pstZone, pstLogGrp, pstLog, nLpn, nDstVpn);
+        FSR_STL_UpdatePMTCost(pstZone, pstLogGrp);
+
+        /* Change the state of log block */
+        FSR_STL_ChangeLogState(pstZone, pstLogGrp, pstLog, nLpn);
+
+#if (OP_SUPPORT_STATISTICS_INFO == 1)
+        /* Experimental data generation for analysis */
+        pstZone->pstStats->nTotalLogPgmCnt++;
+#endif
+
+#if (OP_SUPPORT_STATISTICS_INFO == 1)
+        pstZone->pstStats->nBufferMissCnt++;
+#endif
+    } while (0);
+
+    /* The extended parameter is referenced through pstVFLParam */
+    FSR_STL_FreeVFLExtParam(pstZone,
+                            pstVFLParam->pExtParam);
+
+    FSR_STL_FreeVFLParam(pstZone,
+                            pstVFLParam);
+
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+    return nRet;
+}
+
+/**
+ *  @brief      This function determines where to write, buffer or log block. 
+ * 
+ *  @param[in]  pstZone       : zone object
+ *  @param[in]  pstLog        : log object
+ *  @param[in]  pstParam      : VFL parameter object
+ *  @param[in]  nTrTotalSize  : the size of the transaction
+ *
+ *  @return     TRUE32  : buffer block write
+ *  @return     FALSE32 : log block write
+ *
+ *  @author     Jaesoo Lee
+ *  @version    1.1.0
+ */
+
+PUBLIC BOOL32 
+FSR_STL_DetermineBufferWrite   (STLZoneObj     *pstZone,
+                                STLLog         *pstLog,
+                                VFLParam       *pstParam,
+                                UINT32          nTrTotalSize)
+{
+    RBWDevInfo     *pstDev;
+    BOOL32          bBufferWrite = FALSE32;
+    UINT32          nSctPerVPg;
+    PADDR           nLpn;
+    POFFSET         nCurPOffs = 0;
+    POFFSET         nExpectedPOffs = 0;
+
+    FSR_STACK_VAR;
+    FSR_STACK_END;
+
+    nLpn = pstParam->nLpn;
+
+    /* Get device info pointer */
+    pstDev = pstZone->pstDevInfo;
+
+    nSctPerVPg = pstZone->pstDevInfo->nSecPerVPg;
+
+    /* Determine where to write, buffer or log.*/
+    if (FSR_STL_SearchBufferSlot(pstZone, nLpn) != NULL)
+    {
+        /*
+         * overwrite case :
+         * A buffered page is always written into buffer block, 
+         * so that the buffered page can not be older than the log page.
+         */
+        bBufferWrite = TRUE32;
+    }
+    else if (nTrTotalSize < nSctPerVPg)
+    {
+        /* sub-page write : it is merged in the buffer */
+        bBufferWrite = TRUE32;
+    }
+    else if (!(pstParam->nBitmap &(1 << (nSctPerVPg - 1))))
+    {
+        /* end missing case */
+        if (nTrTotalSize >= nSctPerVPg)
+        {
+            if ((pstLog->nState &LS_STATES_BIT_MASK) == LS_ALLOC)
+            {
+                if (GET_REMAINDER(nLpn, pstDev->nPagesPerSbShift) == 0)
+                {
+                    bBufferWrite = TRUE32;
+                }
+            }
+            else if ((pstLog->nState &LS_STATES_BIT_MASK) == LS_SEQ)
+            {
+                nExpectedPOffs = (POFFSET)GET_REMAINDER(pstLog->nCPOffs, pstDev->nPagesPerSbShift);
+                nCurPOffs = (POFFSET)GET_REMAINDER(nLpn, pstDev->nPagesPerSbShift);
+
+                if (nExpectedPOffs == nCurPOffs)
+                {
+                    bBufferWrite = TRUE32;
+                }
+            }
+        }
+    }
+    return bBufferWrite;
+}
+
+/**
+ *  @brief          This function writes the specified nLpn page into
+ *  @n              buffer block.
+ * 
+ *  @param[in]      pstZone     : partition object
+ *  @param[in]      pstLogGrp   : log group object
+ *  @param[in]      pstLog      : log pointer
+ *  @param[in]      pstParam    : VFL parameter object
+ *
+ *  @return         FSR_STL_SUCCESS
+ *
+ *  @author         Jaesoo Lee
+ *  @version        1.1.0
+ */
+PUBLIC INT32
+FSR_STL_WriteSinglePage    (STLZoneObj     *pstZone,
+                            STLLogGrpHdl   *pstLogGrp,
+                            STLLog         *pstLog,
+                            VFLParam       *pstParam,
+                            UINT32 nTrTotalSize,
+                            BOOL32 bConfirmPage)
+{
+    const   RBWDevInfo *pstDev      = pstZone->pstDevInfo;
+    STLCtxInfoHdl      *pstCtx      = pstZone->pstCtxHdl;
+    STLCtxInfoFm       *pstCtxFm    = pstCtx->pstFm;
+    STLBUCtxObj    *pstBUCtx;
+    STLBUSlot      *pstSlot;
+
+    PADDR           nLpn;
+    POFFSET         nBufNumMaxPgs = 0;
+
+    BADDR           nBBlkVbn;
+    UINT32          nBBlkEC = 0;
+    BOOL32          bNewBBlk = FALSE32;
+
+    PADDR           nBufSrcVpn = NULL_VPN;
+    SBITMAP         nBufSrcBitmap = 0;
+    PADDR           nLogSrcVpn = NULL_VPN;
+    SBITMAP         nLogSrcBitmap = 0;
+    PADDR           nDstVpn = NULL_VPN;
+    SBITMAP         nDstBitmap = 0;
+    PADDR           nSrcVpn = NULL_VPN;
+    SBITMAP         nSrcBitmap = 0;
+
+    BOOL32          bPageDeleted = FALSE32;
+    VFLParam       *pstVFLParam;
+    UINT8          *pCurBufPos;
+    UINT8          *pCurDataPos;
+    BOOL32          bStartCopied = FALSE32;
+
+    const   UINT16  nSctPerVPg      = (UINT16)(pstDev->nSecPerVPg);
+    BOOL32          bBufferWrite    = FALSE32;
+    UINT32          nIdx            = 0;
+    INT32           nRet;
+    BOOL32          bCRCValid = FALSE32;
+    UINT32         *pnCurDstCRC;
+    UINT32         *pnCurSrcCrc;
+    UINT16          nNumExtSData;
+
+    FSR_STACK_VAR;
+    FSR_STACK_END;
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:IN ]  ++%s()\r\n"), __FSR_FUNC__));
+
+    FSR_ASSERT(pstLogGrp->pstFm->nDgn != NULL_DGN);
+    FSR_ASSERT(pstLog->nVbn != NULL_VBN);
+    FSR_ASSERT(pstParam->nNumOfPgs == 1);
+
+    /* When the OneNand 2K device, we only use 2 extensive meta data */
+    nNumExtSData = (nSctPerVPg == STL_2KB_PG) ? nSctPerVPg >> 1 : nSctPerVPg;
+
+    /* Get the buffer unit context */
+    pstBUCtx = pstZone->pstBUCtxObj;
+
+    nLpn = pstParam->nLpn;
+
+    pstParam->nBitmap = pstParam->nBitmap & pstDev->nFullSBitmapPerVPg;
+
+    FSR_ASSERT(nLpn >= (UINT32)(((pstLogGrp->pstFm->nDgn    ) << pstZone->pstRI->nNShift) << pstDev->nPagesPerSbShift));
+    FSR_ASSERT(nLpn <  (UINT32)(((pstLogGrp->pstFm->nDgn + 1) << pstZone->pstRI->nNShift) << pstDev->nPagesPerSbShift));
+
+    FSR_STL_InitCRCs(pstZone, pstParam);
+
+    pstVFLParam = FSR_STL_AllocVFLParam(pstZone);
+
+    pstVFLParam->pExtParam = FSR_STL_AllocVFLExtParam(pstZone);
+    pstVFLParam->pExtParam->nNumExtSData = 0;
+    pstVFLParam->pExtParam->nNumRndIn = 0;
+
+    bBufferWrite = FSR_STL_DetermineBufferWrite(
+        pstZone, pstLog, pstParam, nTrTotalSize);
+
+#if (OP_SUPPORT_STATISTICS_INFO == 1)
+    if(bBufferWrite)
+    {
+        pstZone->pstStats->nBufferWriteCnt++;
+
+        if (FSR_STL_SearchBufferSlot(pstZone, nLpn) != NULL)
+        {
+            pstZone->pstStats->nBufferHitCnt++;
+        }
+    }
+#endif
+
+    if(!bBufferWrite)
+    {
+        /* get clean page address of the log */
+        nDstVpn = FSR_STL_GetLogCPN(pstZone, pstLog, nLpn);
+
+        /* increase the clean page offset of the log */
+        pstLog->nCPOffs++;
+
+#if (OP_SUPPORT_MLC_LSB_ONLY == 1)
+        FSR_STL_CheckMLCFastMode(pstZone, pstLog);
+#endif
+    }
+    else if(bBufferWrite)
+    {
+        /* Context has to be stored if new unit is allocated */
+        nRet = FSR_STL_ReserveMetaPgs(pstZone, 1, TRUE32);
+        if (nRet != FSR_STL_SUCCESS)
+        {
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+            return nRet;
+        }
+        
+        /* We always confirm the buffer */
+        bConfirmPage = TRUE32;
+        
+        nBufNumMaxPgs = _GetBufferMaxPgs(pstZone);
+
+#if (OP_SUPPORT_DATA_WEAR_LEVELING == 1)
+        if (pstBUCtx->nBBlkCPOffset >= nBufNumMaxPgs)
+        {
+            nRet = FSR_STL_WearLevelFreeBlk(pstZone, 1, NULL_DGN);
+            if (nRet != FSR_STL_SUCCESS)
+            {
+                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG | FSR_DBZ_ERROR,
+                    (TEXT("[SIF:ERR] --%s() L(%d): 0x%08x\r\n"),
+                        __FSR_FUNC__, __LINE__, nRet));
+                return nRet;
+            }
+        }
+#endif  /* (OP_SUPPORT_DATA_WEAR_LEVELING == 1) */
+
+        /* Evict a buffered page if nLpn needs a new slot */
+        nRet = _PrepareBufferSlot(pstZone, nLpn);
+        if (nRet != FSR_STL_SUCCESS)
+        {
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+            return nRet;
+        }
+    }
+
+
+/* 
+ * Note: we don't have to initialize CRC field, since we guarantee
+ * that CRC field has been initialized before here.
+ */
+
+    if((!bBufferWrite) &&
+       (pstParam->nBitmap == pstDev->nFullSBitmapPerVPg))
+    {
+        /* set spare data 1, 2, 3 */
+        FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstParam, bConfirmPage);
+
+        if (bConfirmPage)
+        {
+            /* Initialize CRC */
+            FSR_STL_InitCRCs(pstZone, pstParam);
+            FSR_STL_ComputeCRCs(pstZone, NULL, pstParam, FALSE32);
+            pstParam->pExtParam->nNumExtSData = nNumExtSData;
+        }
+
+        nRet = FSR_STL_Convert_ExtParam(pstZone, pstParam);        
+        nRet = FSR_STL_FlashProgram(pstZone, nDstVpn, pstParam);
+        if ( nRet != FSR_BML_SUCCESS )
+        {
+            return nRet;
+        }
+    }
+    else
+    {
+        /* Compute source pages and bitmaps */
+        nSrcVpn = NULL_VPN;
+        nSrcBitmap = 0;
+
+        /*
+         * 1. Src from the buffer
+         * Check for overwrite case
+         */
+        pstSlot = FSR_STL_SearchBufferSlot(pstZone, nLpn);
+        if (pstSlot != NULL)
+        {
+            nBufSrcBitmap = pstSlot->nValidSBitmap;
+            /* Clear bit map for sectors being overwritten */
+            nBufSrcBitmap = nBufSrcBitmap &(~pstParam->nBitmap);
+        }
+        else
+        {
+            nBufSrcBitmap = 0;
+        }
+        nBufSrcVpn = (nBufSrcBitmap == 0 ? NULL_VBN : pstSlot->nBufferedVpn);
+
+        /*
+         * 2. Src from log block or data block
+         *  2.1. Compute the resultant valid bitmap
+         */
+        nDstBitmap = nBufSrcBitmap | pstParam->nBitmap;
+        /* 2.2. Missing scts from start of the page should be copied from data or log block */
+        nLogSrcBitmap = FSR_STL_MarkSBitmap(nDstBitmap);
+
+        if (!bBufferWrite || nLogSrcBitmap)
+        {
+            /* 
+             * Some scts from the start of page are missing 
+             * Thus, we have read it first
+             * find out the old source VPN
+             */
+            nRet = FSR_STL_GetLpn2Vpn(pstZone, nLpn, &nLogSrcVpn, &bPageDeleted);
+            if (nRet != FSR_STL_SUCCESS)
+            {
+                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                    (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+                return nRet;
+            }
+
+            if (!bPageDeleted)
+            {
+                if(bBufferWrite)
+                {
+                    ;/* nLogSrcBitmap = FSR_STL_MarkZeroUntilLastOneofSBitmap(nDstBitmap); */
+                }
+                else
+                {
+                    nLogSrcBitmap = (~nDstBitmap) & pstDev->nFullSBitmapPerVPg;
+                }
+
+                nDstBitmap = nDstBitmap | nLogSrcBitmap;
+            }
+            else
+            {
+                nLogSrcBitmap = 0;
+                nLogSrcVpn = NULL_VPN;
+            }
+        }
+
+        /*
+         * Prepare data 
+         * The 1st case is where data from previous buffer and log or data block should be merged
+         */
+        if (nLogSrcBitmap && nBufSrcBitmap)
+        {
+            /*
+             * Since we guarantee that a buffered sectors are contiguous and start from 
+             * the first sector of the page,
+             * there is only one possible layout as belows.
+             *             _________________
+             *             |   |   |   |   |
+             *             -----------------
+             *     src f/  -->          <--- src f/ log
+             *       buf            
+             *  (1) When the new dat overlaps with the src from the buffer
+             *      - Buffer write && NO SRC FROM LOG --> contradiction
+             *  (2) Whe the new data overlaps with the log src
+             *      - (1) end-full case --> log write
+             *      - (2) otherwise --> buffer write && new data wrapped by log src
+             */
+
+            pstVFLParam->bPgSizeBuf = TRUE32;
+            pstVFLParam->bUserData = FALSE32;
+            pstVFLParam->bSpare = TRUE32;
+
+            FSR_STL_InitCRCs(pstZone, pstVFLParam);
+            pstVFLParam->pExtParam->nNumExtSData = nNumExtSData;
+
+            pstVFLParam->nBitmap = nLogSrcBitmap;
+            pstVFLParam->nNumOfPgs = 1;
+            pstVFLParam->pData     = (UINT8 *)(pstZone->pTempMetaPgBuf);
+
+            nRet = FSR_STL_FlashRead(pstZone, nLogSrcVpn, pstVFLParam, FALSE32);
+            if (nRet != FSR_BML_SUCCESS)
+            {
+                FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                    (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+                return nRet;
+            }
+
+            if (IS_LOG_CRC_VALID(pstVFLParam->nSData3 >> 16))
+            { 
+                bCRCValid = TRUE32;
+            }
+
+            pCurDataPos = pstParam->pData;
+            pCurBufPos   = (UINT8 *)(pstZone->pTempMetaPgBuf);
+            bStartCopied = FALSE32;
+
+            for (nIdx = 0; nIdx < nSctPerVPg; nIdx++)
+            {
+                pnCurSrcCrc = &pstVFLParam->pExtParam->aExtSData[nIdx];
+                pnCurDstCRC = &pstParam->pExtParam->aExtSData[nIdx];
+
+                if ((pstParam->nBitmap) &(1 << nIdx))
+                {
+                    FSR_OAM_MEMCPY(pCurBufPos, pCurDataPos, BYTES_PER_SECTOR);
+                    bStartCopied = TRUE32;
+                }
+                /* We reclaim pre-computed CRC value at best-effort */
+                else if ((nLogSrcBitmap & (1 << nIdx)) &&
+                         (bCRCValid))
+                {
+                    *pnCurDstCRC = *pnCurSrcCrc;
+                }
+
+                if (pstParam->bPgSizeBuf || bStartCopied)
+                {
+                    pCurDataPos += BYTES_PER_SECTOR;
+                }
+                pCurBufPos += BYTES_PER_SECTOR;
+            }
+
+            nSrcBitmap = nBufSrcBitmap;
+            nSrcVpn = nBufSrcVpn;
+
+            pstParam->nBitmap = pstParam->nBitmap | nLogSrcBitmap;
+            pstParam->pData      = (UINT8 *)(pstZone->pTempMetaPgBuf);
+            pstParam->bPgSizeBuf = TRUE32;
+        }
+        else if (nLogSrcBitmap && !nBufSrcBitmap)
+        {
+            nSrcVpn = nLogSrcVpn;
+            nSrcBitmap = nLogSrcBitmap;
+        }
+        else if (!nLogSrcBitmap && nBufSrcBitmap)
+        {
+            nSrcVpn = nBufSrcVpn;
+            nSrcBitmap = nBufSrcBitmap;
+        }
+        else
+        {
+            nSrcVpn = NULL_VPN;
+            nSrcBitmap = 0;
+        }
+
+        if(bBufferWrite)
+        {
+            /*
+             * When current clean page offset equals zero, we need to prepare empty buffer block.
+             * The new buffer block is obtained from free list
+             * NOTE: the context has to be stored after the current buffer page has been written completely.
+             * The last page is not used, since a buffered page needs room for its release.
+             */
+            if ((pstBUCtx->nBBlkCPOffset + 1) >= nBufNumMaxPgs)
+            {
+                FSR_ASSERT(pstCtxFm->nBBlkVbn != NULL_VBN);
+                FSR_ASSERT(FSR_STL_IsBufferDirty(pstZone) == FALSE32);
+
+                /* Swap VBNs & ECs */
+                nBBlkVbn = pstCtx->pFreeList[pstCtxFm->nFreeListHead];
+                nBBlkEC  = pstCtx->pFBlksEC [pstCtxFm->nFreeListHead] + 1;
+
+                pstCtx->pFreeList[pstCtxFm->nFreeListHead] = pstCtxFm->nBBlkVbn;
+                pstCtx->pFBlksEC [pstCtxFm->nFreeListHead] = pstCtxFm->nBBlkEC;
+
+                pstCtxFm->nBBlkVbn = nBBlkVbn;
+                pstCtxFm->nBBlkEC  = nBBlkEC;
+
+                /* Get buffer blocks' VBN */
+                nRet = FSR_STL_FlashErase(pstZone, nBBlkVbn);
+                if (nRet != FSR_BML_SUCCESS)
+                {
+                    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+                    return nRet;
+                }
+
+                FSR_ASSERT(nBBlkVbn != NULL_VBN);
+
+                pstBUCtx->nBBlkCPOffset = 0;
+                bNewBBlk = TRUE32;
+            }
+            else
+            {
+                /* Get buffer blocks' VBN */
+                nBBlkVbn = pstCtxFm->nBBlkVbn;
+                FSR_ASSERT(nBBlkVbn != NULL_VBN);
+            }
+
+            /*
+             * Destination address : inside of buffer block
+             * VPN to write the context
+             */
+            if (pstDev->nDeviceType == RBW_DEVTYPE_MLC)
+            {
+                nDstVpn = (nBBlkVbn << pstDev->nPagesPerSbShift)
+                              + FSR_BML_GetVPgOffOfLSBPg(pstZone->nVolID, pstBUCtx->nBBlkCPOffset);
+            }
+            else
+            {
+                nDstVpn = (nBBlkVbn << pstDev->nPagesPerSbShift)
+                        + pstBUCtx->nBBlkCPOffset;
+            }
+
+            pstParam->bUserData = FALSE32;
+            pstParam->bSpare = TRUE32;
+
+            /*
+             * Prepare spare data
+             * First, fIll SData1 ~ SData2 as follows
+             *      SData1: LPN
+             *      SData2: ~LPN
+             *      SData3: PTF.~PTF
+             */
+            pstParam->nSData1 = nLpn;
+            pstParam->nSData2 = ~nLpn;
+
+            /* Fill PTF into SData3 */
+            pstParam->nSData3 = FSR_STL_SetPTF(pstZone, TF_BU, 0, 0,
+                                    sizeof(SBITMAP) * 8 - (UINT8)FSR_STL_GetZBC((UINT8 *)( &nDstBitmap), sizeof(SBITMAP)));
+            pstParam->nSData3 = (pstParam->nSData3 << 16) | (0xffff & (~pstParam->nSData3));
+        }
+        else
+        {
+            if(nBufSrcBitmap)
+            {
+                bConfirmPage = TRUE32;
+            }
+            /* set spare data 1, 2, 3 */
+            FSR_STL_SetLogSData123(pstZone, nLpn, nDstVpn, pstParam, bConfirmPage); 
+        }
+
+        
+        /* If the target page is deleted, there is no valid data in that logical page.*/
+        if ((nSrcBitmap == 0) ||
+            (nSrcVpn    == NULL_VPN))
+        {
+            /* Buffer is filled solely by the source data */
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("VFL_Program : nLpn = %d, nDstVpn = %d(%d)\n"), nLpn, nDstVpn, GET_REMAINDER(nDstVpn, pstDev->
+                nPagesPerSbShift) ));
+
+            if(bConfirmPage)
+            {
+                FSR_STL_ComputeCRCs(pstZone, NULL, pstParam, FALSE32);
+                pstParam->pExtParam->nNumExtSData = nNumExtSData;
+            }
+
+            nRet = FSR_STL_Convert_ExtParam(pstZone, pstParam);
+            nRet = FSR_STL_FlashProgram(pstZone, nDstVpn, pstParam);
+        }
+        else
+        {
+            /* Buffer has to be filled by the temporal buffer */
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("VFL_Copyback : nLpn = %d, nSrcVpn = %d, nDstVbn = %d, nDstVpn = %d(%d)\n"), nLpn, nSrcVpn, nDstVpn
+                / pstDev->nPagesPerSBlk, nDstVpn, GET_REMAINDER(nDstVpn, pstDev->nPagesPerSbShift) ));
+
+            if(bConfirmPage)
+            {
+                nRet = FSR_STL_FlashModiCopybackCRC(pstZone, nSrcVpn, nDstVpn, pstParam);
+            }
+            else
+            {        
+                nRet = FSR_STL_Convert_ExtParam(pstZone, pstParam);
+        
+                nRet = FSR_STL_FlashModiCopyback(pstZone, nSrcVpn, nDstVpn, pstParam);
+            }
+        }
+
+        if (nRet != FSR_BML_SUCCESS)
+        {
+            FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+            return nRet;
+        }
+
+        if(bBufferWrite)
+        {
+            /* Update state */
+            FSR_ASSERT(pstLogGrp->pstFm->nDgn == 
+                       ((nLpn >> pstDev->nPagesPerSbShift) >> pstZone->pstRI->nNShift));
+            FSR_STL_SetBufferSlot(pstZone, nLpn, nDstVpn, nDstBitmap);
+
+            /* Move clean page offset */
+            pstBUCtx->nBBlkCPOffset++;
+
+            /*
+             * Store context info
+             * The buffered pages are found by the scan of buffer block,
+             * so the context is stored only when the buffer block is replaced.
+             */
+            if (bNewBBlk == TRUE32)
+            {
+                nRet = FSR_STL_StoreBMTCtx(pstZone, FALSE32);
+                if (nRet != FSR_STL_SUCCESS)
+                {
+                    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+                        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+                    return nRet;
+                }
+            }
+        }
+    }
+
+#if (OP_SUPPORT_STATISTICS_INFO == 1)
+    if(!bBufferWrite && nBufSrcBitmap) 
+    {
+        pstZone->pstStats->nBufferHitCnt++;
+    }
+#endif
+
+    if(!bBufferWrite)
+    {
+        /* log group PMT update */
+        FSR_STL_UpdatePMT(pstZone, pstLogGrp, pstLog, nLpn, nDstVpn);
+
+        /* change the state of log block */
+        FSR_STL_ChangeLogState(pstZone, pstLogGrp, pstLog, nLpn);
+
+#if (OP_SUPPORT_STATISTICS_INFO == 1)
+        pstZone->pstStats->nTotalLogPgmCnt++;
+#endif  /* (OP_SUPPORT_STATISTICS_INFO == 1) */
+    }
+
+    FSR_STL_FreeVFLExtParam(pstZone, pstVFLParam->pExtParam);
+
+    FSR_STL_FreeVFLParam(pstZone, pstVFLParam);
+
+    FSR_DBZ_DBGMOUT(FSR_DBZ_STL_LOG,
+        (TEXT("[SIF:OUT]  --%s() : 0x%08x\r\n"), __FSR_FUNC__, nRet));
+    return FSR_STL_SUCCESS;
+}
+
+#endif  /* (OP_SUPPORT_PAGE_MISALIGNED_WRITE == 1) */
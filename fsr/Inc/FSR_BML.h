@@ -152,6 +152,9 @@ extern "C" {
 
 #define     FSR_BML_FLAG_PRIORITY_MASK              (0x0000f000)
 #define     FSR_BML_FLAG_PRIORITY_BASEBIT           (12)
+/* Background request (merge, refresh and so on).
+ * It releases the volume semaphore more often than a normal request */
+#define     FSR_BML_FLAG_PRIORITY_BACKGROUND        (0x00008000)
 
 /* nFlag value for FSR_BML_Format() */
 #define     FSR_BML_INIT_FORMAT                     (0x00000000)
@@ -806,6 +809,9 @@ INT32   FSR_BML_LoadPIEntry      (UINT32        nVol,
 INT32   FSR_BML_EraseRefresh     (UINT32        nVol,
                                   UINT32        nNumOfUnit,
                                   UINT32        nFlag);
+INT32   FSR_BML_Scrub            (UINT32        nVol,
+                                  UINT32        nNumOfUnit,
+                                  UINT32        nFlag);
 INT32   FSR_BML_FlushOp          (UINT32        nVol,
                                   UINT32        nFlag);
 #endif
@@ -145,6 +145,7 @@ typedef struct
                                                  from Page Buffer to DataRAM */
 
             BOOL32      bCachePgm;      /**< supports cache program          */
+            BOOL32      bEraseSuspend;  /**< supports erase suspend/resume   */
 
             /* TrTime, TwTime of MLC are array of size 2
              * first  element is for LSB TLoadTime, TProgTime
@@ -562,6 +563,19 @@ typedef struct
                                                        FSR_METHOD_INOUT_DIRECT,\
                                                        FSR_ANY_ACCESS)
 
+/* FSR_LLD_IOCTL_ERASE_SUSPEND/RESUME take the die index (UINT32) as pBufI.
+ * FSR_LLD_IOCTL_ERASE_SUSPEND returns TRUE32 in pBufO (BOOL32)
+ * when an erase was in progress on the die and has been suspended          */
+#define     FSR_LLD_IOCTL_ERASE_SUSPEND FSR_IOCTL_CODE(FSR_MODULE_LLD,         \
+                                                       0x10,                   \
+                                                       FSR_METHOD_INOUT_DIRECT,\
+                                                       FSR_ANY_ACCESS)
+
+#define     FSR_LLD_IOCTL_ERASE_RESUME  FSR_IOCTL_CODE(FSR_MODULE_LLD,         \
+                                                       0x11,                   \
+                                                       FSR_METHOD_INOUT_DIRECT,\
+                                                       FSR_ANY_ACCESS)
+
 
 /* FSR_LLD_IOCTL_PI_READ/WRITE takes pointer to LLDPIArg as pBufO, pBufI
  * a member of LLDPIArg takes one of followings
@@ -321,6 +321,14 @@ INT32    FSR_OAM_ReadDMA                (UINT32     nVirDstAddr,
 INT32    FSR_OAM_WriteDMA               (UINT32     nVirDstAddr,
                                          UINT32     nVirSrcAddr,
                                          UINT32     nSize);
+INT32    FSR_OAM_ReadDMAAsync           (UINT32     nVirDstAddr,
+                                         UINT32     nVirSrcAddr,
+                                         UINT32     nSize,
+                                         UINT32     nEvent);
+INT32    FSR_OAM_WriteDMAAsync          (UINT32     nVirDstAddr,
+                                         UINT32     nVirSrcAddr,
+                                         UINT32     nSize,
+                                         UINT32     nEvent);
 
 /*****************************************************************************/
 /* APIs for Timer (ONLY for performance measurement)                         */
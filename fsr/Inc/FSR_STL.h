@@ -317,6 +317,120 @@
                                                         FSR_METHOD_IN_DIRECT,   \
                                                         FSR_WRITE_ACCESS)
 
+/*****************************************************************************/
+/*  UINT32       nVol;                                                       */
+/*  UINT32       nPartID;                                                    */
+/*  UINT32       nIdleMSec;                                                  */
+/*                                                                           */
+/*  nVol         = 0;                                                        */
+/*  nPartID      = FSR_PARTID_STL0;                                          */
+/*  nIdleMSec    = 100;                                                      */
+/*                                                                           */
+/*  FSR_STL_IOCtl  (nVol, nPartID, FSR_STL_IOCTL_IDLE_FLUSH_WB,              */
+/*                  (VOID *) &nIdleMSec, sizeof(nIdleMSec), NULL, 0,         */
+/*                  NULL);                                                   */
+/*****************************************************************************/
+#define FSR_STL_IOCTL_IDLE_FLUSH_WB          FSR_IOCTL_CODE(FSR_MODULE_STL, 12, \
+                                                        FSR_METHOD_IN_DIRECT,   \
+                                                        FSR_WRITE_ACCESS)
+
+/*****************************************************************************/
+/*  UINT32       nVol;                                                       */
+/*  UINT32       nPartID;                                                    */
+/*  UINT32       nMSec;                                                      */
+/*                                                                           */
+/*  nVol         = 0;                                                        */
+/*  nPartID      = FSR_PARTID_STL0;                                          */
+/*  nMSec        = 200;                                                      */
+/*                                                                           */
+/*  FSR_STL_IOCtl  (nVol, nPartID, FSR_STL_IOCTL_DEFRAG_ONLINE,              */
+/*                  (VOID *) &nMSec, sizeof(nMSec), NULL, 0,                 */
+/*                  NULL);                                                   */
+/*****************************************************************************/
+#define FSR_STL_IOCTL_DEFRAG_ONLINE          FSR_IOCTL_CODE(FSR_MODULE_STL, 13, \
+                                                        FSR_METHOD_IN_DIRECT,   \
+                                                        FSR_WRITE_ACCESS)
+
+/*****************************************************************************/
+/*  UINT32          nVol;                                                    */
+/*  UINT32          nPartID;                                                 */
+/*  UINT32          nBytesReturned;                                          */
+/*  FSRStlECSummary stECSum;                                                 */
+/*                                                                           */
+/*  nVol         = 0;                                                        */
+/*  nPartID      = FSR_PARTID_STL0;                                          */
+/*                                                                           */
+/*  FSR_STL_IOCtl  (nVol, nPartID, FSR_STL_IOCTL_READ_ECNT_SUMMARY,          */
+/*                  NULL, 0, &stECSum, sizeof(stECSum),                      */
+/*                  &nBytesReturned);                                        */
+/*****************************************************************************/
+#define FSR_STL_IOCTL_READ_ECNT_SUMMARY      FSR_IOCTL_CODE(FSR_MODULE_STL, 14, \
+                                                        FSR_METHOD_OUT_DIRECT,  \
+                                                        FSR_READ_ACCESS)
+
+/*****************************************************************************/
+/*  UINT32       nVol;                                                       */
+/*  UINT32       nPartID;                                                    */
+/*  UINT32       nMaxMoves;                                                  */
+/*  UINT32       nMoves;                                                     */
+/*  UINT32       nBytesReturned;                                             */
+/*                                                                           */
+/*  nVol         = 0;                                                        */
+/*  nPartID      = FSR_PARTID_STL0;                                          */
+/*  nMaxMoves    = 1;                                                        */
+/*                                                                           */
+/*  FSR_STL_IOCtl  (nVol, nPartID, FSR_STL_IOCTL_WEAR_LEVEL,                 */
+/*                  (VOID *) &nMaxMoves, sizeof(nMaxMoves),                  */
+/*                  &nMoves, sizeof(nMoves), &nBytesReturned);               */
+/*****************************************************************************/
+#define FSR_STL_IOCTL_WEAR_LEVEL             FSR_IOCTL_CODE(FSR_MODULE_STL, 15, \
+                                                        FSR_METHOD_IN_DIRECT,   \
+                                                        FSR_WRITE_ACCESS)
+
+/*****************************************************************************/
+/*  UINT32          nVol;                                                    */
+/*  UINT32          nPartID;                                                 */
+/*  UINT32          nBytesReturned;                                          */
+/*  UINT32          nNandPgs;                                                */
+/*  UINT32          nIdx;                                                    */
+/*  FSRStlWAStats   stWA;                                                    */
+/*                                                                           */
+/*  nVol         = 0;                                                        */
+/*  nPartID      = FSR_PARTID_STL0;                                          */
+/*                                                                           */
+/*  FSR_STL_IOCtl  (nVol, nPartID, FSR_STL_IOCTL_RESET_WA_STATS,             */
+/*                  NULL, 0, NULL, 0, &nBytesReturned);                      */
+/*                                                                           */
+/*  // Some Stl Operation                                                    */
+/*                                                                           */
+/*  FSR_STL_IOCtl  (nVol, nPartID, FSR_STL_IOCTL_GET_WA_STATS,               */
+/*                  NULL, 0, &stWA, sizeof(stWA), &nBytesReturned);          */
+/*                                                                           */
+/*  nNandPgs = 0;                                                            */
+/*  for (nIdx = 0; nIdx < FSR_STL_WA_CAUSES; nIdx++)                         */
+/*  {                                                                        */
+/*      nNandPgs += stWA.naPgmPgs[nIdx];                                     */
+/*  }                                                                        */
+/*  // WAF = nNandPgs * stWA.nSctsPerPg / stWA.nHostWrScts                   */
+/*****************************************************************************/
+#define FSR_STL_IOCTL_GET_WA_STATS           FSR_IOCTL_CODE(FSR_MODULE_STL, 16, \
+                                                        FSR_METHOD_OUT_DIRECT,  \
+                                                        FSR_READ_ACCESS)
+
+#define FSR_STL_IOCTL_RESET_WA_STATS         FSR_IOCTL_CODE(FSR_MODULE_STL, 17, \
+                                                        FSR_METHOD_OUT_DIRECT,  \
+                                                        FSR_READ_ACCESS)
+
+/* causes of NAND programs and erases for FSR_STL_IOCTL_GET_WA_STATS */
+#define FSR_STL_WA_USER                     (0)     /* host data written by the STL  */
+#define FSR_STL_WA_MERGE                    (1)     /* log block merge (reclaim)     */
+#define FSR_STL_WA_COMPACT                  (2)     /* active log compaction, defrag */
+#define FSR_STL_WA_WL                       (3)     /* wear-leveling                 */
+#define FSR_STL_WA_GC                       (4)     /* garbage collection            */
+#define FSR_STL_WA_META                     (5)     /* map, context and root pages   */
+#define FSR_STL_WA_WBUF                     (6)     /* write buffer partition        */
+#define FSR_STL_WA_CAUSES                   (7)
+
 /**
  * @brief       data structure of the parameter of FSR_STL_Format
  */
@@ -357,6 +471,33 @@ typedef struct
     UINT32          nCtxPgmCnt;             /**< total meta page program count      */
 } FSRStlStats;
 
+/**
+ * @brief       data structure of the output of FSR_STL_IOCTL_READ_ECNT_SUMMARY
+ */
+#define FSR_STL_EC_HIST_BINS                (16)
+
+typedef struct
+{
+    UINT32          nNumBlks;               /**< number of counted blocks           */
+    UINT32          nNumMetaBlks;           /**< number of meta (and root) blocks   */
+    UINT32          nMinEC;                 /**< minimum erase count                */
+    UINT32          nMaxEC;                 /**< maximum erase count                */
+    UINT32          nAvgEC;                 /**< average erase count                */
+    UINT32          nBinWidth;              /**< erase count range of a bin         */
+    UINT32          naHist[FSR_STL_EC_HIST_BINS];   /**< # of blks of [nMinEC + i * nBinWidth, +nBinWidth) */
+} FSRStlECSummary;
+
+/**
+ * @brief       data structure of the output of FSR_STL_IOCTL_GET_WA_STATS
+ */
+typedef struct
+{
+    UINT32          nHostWrScts;            /**< # of sectors written by the host   */
+    UINT32          nSctsPerPg;             /**< # of sectors per page              */
+    UINT32          naPgmPgs[FSR_STL_WA_CAUSES];    /**< # of programmed pages by cause */
+    UINT32          naErsBlks[FSR_STL_WA_CAUSES];   /**< # of erased blocks by cause    */
+} FSRStlWAStats;
+
 /**
  * @brief       data structure of the parameter of FSR_STL_Open
  */
@@ -368,6 +509,15 @@ typedef struct
     UINT32  nTotalLogUnits;  /**< Output : The number of total logical units   */
 } FSRStlInfo;
 
+/**
+ * @brief       data structure of an extent for FSR_STL_DeleteExt
+ */
+typedef struct
+{
+    UINT32  nLsn;           /**< Input : start logical sector number           */
+    UINT32  nNumOfScts;     /**< Input : the number of sectors to delete       */
+} FSRStlDelExt;
+
 
 #if defined(FSR_STL_FOR_PRE_PROGRAMMING)
 /**
@@ -426,6 +576,11 @@ PUBLIC INT32    FSR_STL_Delete (UINT32          nVol,
                                 UINT32          nLsn,
                                 UINT32          nNumOfScts,
                                 UINT32          nFlag);
+PUBLIC INT32    FSR_STL_DeleteExt  (UINT32          nVol,
+                                    UINT32          nPartID,
+                                    FSRStlDelExt   *pstExt,
+                                    UINT32          nNumOfExt,
+                                    UINT32          nFlag);
 PUBLIC INT32    FSR_STL_IOCtl  (UINT32          nVol,
                                 UINT32          nPartID,
                                 UINT32          nCode,
@@ -65,6 +65,7 @@
 #define     FSR_LLD_USE_CACHE_PGM
 //#define     FSR_LLD_WAIT_ALLDIE_PGM_READY
 #define     FSR_LLD_USE_SUPER_LOAD
+#define     FSR_LLD_USE_ERASE_SUSPEND
 //#define     FSR_LLD_WAIT_WR_PROTECT_STAT
 //#define     FSR_LLD_ENABLE_DEBUG_PORT
 //#define     FSR_LLD_PE_TEST
@@ -202,6 +203,8 @@
 #define     FSR_FND_CMD_HOT_RESET           (0x00F3)
 #define     FSR_FND_CMD_OTP_ACCESS          (0x0065)
 #define     FSR_FND_CMD_ACCESS_PI           (0x0066)
+#define     FSR_FND_CMD_ERASE_SUSPEND       (0x00B0)
+#define     FSR_FND_CMD_ERASE_RESUME        (0x0030)
 
 /* 14th bit of Controller Status Register (F240h) of OneNAND shows
  * whether host is programming/erasing a locked block of the NAND Flash Array
@@ -441,6 +444,8 @@ const   UINT8      *pLSBPgMap;          /**< array of LSB pages               */
         UINT32      nSLCPECycle;        /**< program, erase cycle of SLC block*/
         UINT32      nMLCPECycle;        /**< program, erase cycle of MLC block*/
 
+        BOOL32      bEraseSuspend;      /**< supports erase suspend/resume    */
+
 } FlexONDSpec;
 
 /** @brief   shared data structure for communication in Dual Core             */
@@ -473,9 +478,14 @@ typedef struct
     UINT16       nFlushOpCaller;
 
     BOOL32       bCachePgm;             /**< supports cache program           */
+    BOOL32       bEraseSuspend;         /**< supports erase suspend/resume    */
 
     BOOL32       bIsPreCmdCache[FSR_MAX_DIES];
 
+    BOOL32       bEraseSuspended[FSR_MAX_DIES];/**< erase is suspended        */
+    UINT16       nSuspendedPbn[FSR_MAX_DIES];  /**< Pbn of suspended erase    */
+    UINT32       nSuspendedFlag[FSR_MAX_DIES]; /**< flag of suspended erase   */
+
     UINT16       nBlksForSLCArea[FSR_MAX_DIES];/**< # of blocks for SLC area  */
 
     UINT8       *pSpareBuffer;          /**< can cover all spare area of 1 pg */
@@ -695,17 +705,18 @@ PRIVATE const FlexONDSpec gstFNDSpec[] = {
 /* 21.                                                                                                                nTEraseTime            */
 /* 22                                                                                                                      nSLCPECycle       */
 /* 23                                                                                                                             nMLCPECycle*/
+/* 24                                                                                                                                    bEraseSuspend */
 /**********************************************************************************************************************/
     /* 4Gb */
-    { 0x00EC, 0x0250, 0, 1024, 1, 1, 8, 16, 64, 128, TRUE32, 50, 26, gnPairPgMap, gnLSBPgs, 45, 50, 240, {240, 1760}, 500, 50000, 10000},
+    { 0x00EC, 0x0250, 0, 1024, 1, 1, 8, 16, 64, 128, TRUE32, 50, 26, gnPairPgMap, gnLSBPgs, 45, 50, 240, {240, 1760}, 500, 50000, 10000, TRUE32},
 
     /* 8Gb DDP */
-    { 0x00EC, 0x0268, 0, 2048, 2, 1, 8, 16, 64, 128, TRUE32, 50, 52, gnPairPgMap, gnLSBPgs, 45, 50, 240, {240, 1760}, 500, 50000, 10000},
+    { 0x00EC, 0x0268, 0, 2048, 2, 1, 8, 16, 64, 128, TRUE32, 50, 52, gnPairPgMap, gnLSBPgs, 45, 50, 240, {240, 1760}, 500, 50000, 10000, TRUE32},
 
     /* 8Gb MDP */
-    { 0x00EC, 0x0260, 0, 2048, 1, 1, 8, 16, 64, 128, TRUE32, 50, 52, gnPairPgMap, gnLSBPgs, 45, 50, 240, {240, 1760}, 500, 50000, 5000},
+    { 0x00EC, 0x0260, 0, 2048, 1, 1, 8, 16, 64, 128, TRUE32, 50, 52, gnPairPgMap, gnLSBPgs, 45, 50, 240, {240, 1760}, 500, 50000, 5000, TRUE32},
 
-    {      0,      0, 0,    0, 0, 0, 0,  0, 0,  0,  FALSE32,  0,  0,        NULL,        0,  0,  0,   0, {  0,    0},   0,     0,     0},
+    {      0,      0, 0,    0, 0, 0, 0,  0, 0,  0,  FALSE32,  0,  0,        NULL,        0,  0,  0,   0, {  0,    0},   0,     0,     0, FALSE32},
 };
 
 /******************************************************************************/
@@ -1444,6 +1455,13 @@ FSR_FND_Open(UINT32  nDev,
             pstFNDCxt->bCachePgm                    = TRUE32;
         }
 
+        /* erase suspend is used only on the parts whose spec entry allows it */
+        pstFNDCxt->bEraseSuspend                = pstFNDCxt->pstFNDSpec->bEraseSuspend;
+
+#if !defined(FSR_LLD_USE_ERASE_SUSPEND)
+        pstFNDCxt->bEraseSuspend                = FALSE32;
+#endif
+
 #if !defined(FSR_LLD_USE_CACHE_PGM)
         pstFNDCxt->bCachePgm                    = FALSE32;
         gnPgmCmdArray[FSR_LLD_FLAG_1X_CACHEPGM] = 0x0080;
@@ -4241,6 +4259,7 @@ FSR_FND_GetDevSpec(UINT32      nDev,
         pstDevSpec->nPgBufToDataRAMTime = FSR_FND_PAGEBUF_TO_DATARAM_TIME;
 
         pstDevSpec->bCachePgm           = pstFNDCxt->bCachePgm;
+        pstDevSpec->bEraseSuspend       = pstFNDCxt->bEraseSuspend;
 
 
         pstDevSpec->nSLCTLoadTime       = pstFNDSpec->nSLCTLoadTime;
@@ -4516,6 +4535,8 @@ FSR_FND_GetPrevOpData(UINT32       nDev,
  * @n                             FSR_LLD_IOCTL_GET_LOCK_STAT
  * @n                             FSR_LLD_IOCTL_HOT_RESET
  * @n                             FSR_LLD_IOCTL_CORE_RESET
+ * @n                             FSR_LLD_IOCTL_ERASE_SUSPEND
+ * @n                             FSR_LLD_IOCTL_ERASE_RESUME
  * @param[in]       pBufI       : Input Buffer pointer
  * @param[in]       nLenI       : Length of Input Buffer
  * @param[out]      pBufO       : Output Buffer pointer
@@ -4565,6 +4586,7 @@ FSR_FND_IOCtl(UINT32  nDev,
              UINT32            nPbn;
              UINT32            nErrorPbn = 0;
              UINT32            nRSVofPI;
+             UINT32            nFlushOpCaller;
 
              INT32             nLLDRe    = FSR_LLD_SUCCESS;
              BOOL32            bPILocked;
@@ -5155,6 +5177,130 @@ FSR_FND_IOCtl(UINT32  nDev,
             }
             break;
 
+        /* erase suspend/resume is kept in step with the other Flex-OneNAND
+         * LLD by hand. each platform builds its own fork of this file and
+         * the LLDs share no common source */
+        case FSR_LLD_IOCTL_ERASE_SUSPEND:
+            if ((pBufI == NULL) || (nLenI != sizeof(UINT32)) ||
+                (pBufO == NULL) || (nLenO != sizeof(BOOL32)))
+            {
+                FSR_DBZ_RTLMOUT(FSR_DBZ_ERROR,
+                    (TEXT("[FND:ERR]   %s() / %d line\r\n"),
+                    __FSR_FUNC__, __LINE__));
+
+                FSR_DBZ_RTLMOUT(FSR_DBZ_ERROR,
+                    (TEXT("            invalid parameter pBufI = 0x%08x, nLenI = %d, pBufO = 0x%08x, nLenO = %d\r\n"),
+                    pBufI, nLenI, pBufO, nLenO));
+
+                nLLDRe = FSR_LLD_INVALID_PARAM;
+                break;
+            }
+
+            nDie = *(UINT32 *) pBufI;
+
+            FSR_ASSERT((nDie & ~0x1) == 0);
+
+            *(BOOL32 *) pBufO = FALSE32;
+
+            if (pByteRet != NULL)
+            {
+                *pByteRet = (UINT32) sizeof(BOOL32);
+            }
+
+            if (pstFNDCxt->bEraseSuspend != TRUE32)
+            {
+                nLLDRe = FSR_LLD_IOCTL_NOT_SUPPORT;
+                break;
+            }
+
+            /* nothing to suspend unless an erase is still running on nDie */
+            if ((pstFNDShMem->nPreOp[nDie] != FSR_FND_PREOP_ERASE) ||
+                (pstFNDCxt->bEraseSuspended[nDie] == TRUE32))
+            {
+                break;
+            }
+
+            /* set DBS */
+            FND_WRITE(pstFOReg->nStartAddr2,
+                (UINT16) (nDie << FSR_FND_DBS_BASEBIT));
+
+            if ((FND_READ(pstFOReg->nInt) & FSR_FND_INT_ERASE_READY) != 0)
+            {
+                /* erase already finished, FlushOp() checks its status */
+                break;
+            }
+
+            FND_WRITE(pstFOReg->nCmd, FSR_FND_CMD_ERASE_SUSPEND);
+
+            WAIT_FND_INT_STAT(pstFOReg, FSR_FND_INT_MASTER_READY);
+
+            pstFNDCxt->bEraseSuspended[nDie] = TRUE32;
+            pstFNDCxt->nSuspendedPbn[nDie]   = pstFNDShMem->nPreOpPbn[nDie];
+            pstFNDCxt->nSuspendedFlag[nDie]  = pstFNDShMem->nPreOpFlag[nDie];
+
+            /* the die is free for other operations until it is resumed */
+            pstFNDShMem->nPreOp[nDie]         = FSR_FND_PREOP_IOCTL;
+            pstFNDShMem->nPreOpPbn[nDie]      = FSR_FND_PREOP_ADDRESS_NONE;
+            pstFNDShMem->nPreOpPgOffset[nDie] = FSR_FND_PREOP_ADDRESS_NONE;
+            pstFNDShMem->nPreOpFlag[nDie]     = FSR_FND_PREOP_FLAG_NONE;
+
+            *(BOOL32 *) pBufO = TRUE32;
+            break;
+
+        case FSR_LLD_IOCTL_ERASE_RESUME:
+            if ((pBufI == NULL) || (nLenI != sizeof(UINT32)))
+            {
+                FSR_DBZ_RTLMOUT(FSR_DBZ_ERROR,
+                    (TEXT("[FND:ERR]   %s() / %d line\r\n"),
+                    __FSR_FUNC__, __LINE__));
+
+                FSR_DBZ_RTLMOUT(FSR_DBZ_ERROR,
+                    (TEXT("            invalid parameter pBufI = 0x%08x, nLenI = %d\r\n"), pBufI, nLenI));
+
+                nLLDRe = FSR_LLD_INVALID_PARAM;
+                break;
+            }
+
+            nDie = *(UINT32 *) pBufI;
+
+            FSR_ASSERT((nDie & ~0x1) == 0);
+
+            if (pByteRet != NULL)
+            {
+                *pByteRet = (UINT32) 0;
+            }
+
+            if (pstFNDCxt->bEraseSuspended[nDie] != TRUE32)
+            {
+                break;
+            }
+
+            /* finish the operations issued while the erase was suspended.
+             * the erase is resumed even if they failed */
+            nFlushOpCaller = FSR_FND_PREOP_IOCTL << FSR_FND_FLUSHOP_CALLER_BASEBIT;
+
+            nLLDRe = FSR_FND_FlushOp(nDev, nFlushOpCaller | nDie, FSR_LLD_FLAG_NONE);
+
+            /* set DBS */
+            FND_WRITE(pstFOReg->nStartAddr2,
+                (UINT16) (nDie << FSR_FND_DBS_BASEBIT));
+
+            /* restore the interrupt mode of the suspended erase */
+            if (pstFNDCxt->nSuspendedFlag[nDie] & FSR_LLD_FLAG_INT_MASK)
+            {
+                FSR_OAM_ClrNEnableInt(pstFNDCxt->nIntID);
+            }
+
+            FND_WRITE(pstFOReg->nCmd, FSR_FND_CMD_ERASE_RESUME);
+
+            pstFNDShMem->nPreOp[nDie]         = FSR_FND_PREOP_ERASE;
+            pstFNDShMem->nPreOpPbn[nDie]      = pstFNDCxt->nSuspendedPbn[nDie];
+            pstFNDShMem->nPreOpPgOffset[nDie] = FSR_FND_PREOP_ADDRESS_NONE;
+            pstFNDShMem->nPreOpFlag[nDie]     = pstFNDCxt->nSuspendedFlag[nDie];
+
+            pstFNDCxt->bEraseSuspended[nDie]  = FALSE32;
+            break;
+
         default:
             nLLDRe = FSR_LLD_IOCTL_NOT_SUPPORT;
             break;
@@ -5170,6 +5316,10 @@ FSR_FND_IOCtl(UINT32  nDev,
                 pstFNDShMem->nPreOpFlag[nDie]     = FSR_FND_PREOP_FLAG_NONE;
             }
         }
+        else if ((nCode == FSR_LLD_IOCTL_ERASE_SUSPEND) || (nCode == FSR_LLD_IOCTL_ERASE_RESUME))
+        {
+            /* previous operation log is maintained by each case */
+        }
         else if ((nLLDRe != FSR_LLD_INVALID_PARAM) && (nLLDRe != FSR_LLD_IOCTL_NOT_SUPPORT))
         {
             FSR_ASSERT(nDie != 0xFFFFFFFF);
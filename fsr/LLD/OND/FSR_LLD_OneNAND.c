@@ -4546,6 +4546,7 @@ FSR_OND_GetDevSpec(UINT32      nDev,
 
         pstDevSpec->nNANDType                       = FSR_LLD_SLC_ONENAND;
         pstDevSpec->bCachePgm                       = TRUE32;   /* always TRUE32 */
+        pstDevSpec->bEraseSuspend                   = FALSE32;
 
         FSR_OAM_MEMCPY(&pstDevSpec->nUID[0], &pstONDCxt->nUID[0] , sizeof(UINT8) * 16);
 
@@ -4405,6 +4405,7 @@ FSR_OND_4K_GetDevSpec(UINT32      nDev,
         pstDevSpec->nPgBufToDataRAMTime = FSR_OND_4K_PAGEBUF_TO_DATARAM_TIME;
 
         pstDevSpec->bCachePgm           = pstOND4kCxt->bCachePgm;
+        pstDevSpec->bEraseSuspend       = FALSE32;
 
 
         pstDevSpec->nSLCTLoadTime       = pstOND4kSpec->nSLCTLoadTime;
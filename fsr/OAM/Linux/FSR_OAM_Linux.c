@@ -43,6 +43,9 @@
 #include <linux/version.h>
 #include <linux/vmalloc.h>
 #include <linux/delay.h>
+#include <linux/completion.h>
+#include <linux/workqueue.h>
+#include <linux/spinlock.h>
 #include <linux/fsr_if.h>
 
 #include <asm/io.h>
@@ -94,6 +97,15 @@
 /*****************************************************************************/
 /* Local typedefs                                                            */
 /*****************************************************************************/
+/* a transfer queued to the software DMA engine                              */
+typedef struct
+{
+    struct work_struct  stWork;     /* work item run by gpstDMAWq            */
+    UINT32              nDstAddr;   /* virtual destination address           */
+    UINT32              nSrcAddr;   /* virtual source address                */
+    UINT32              nSize;      /* # of bytes to transfer                */
+    UINT32              nEvent;     /* event sent when the transfer is done  */
+} FsrDMAReq;
 
 /*****************************************************************************/
 /* Local constant definitions                                                */
@@ -129,6 +141,15 @@ PRIVATE UINT32  gnFSRNumOfMemReqs = 0;
 static struct timeval start;
 static struct timeval stop;
 
+/* events for non-blocking I/O and asynchronous DMA completion */
+PRIVATE struct completion       gstEvent[FSR_OAM_MAX_EVENTS];
+PRIVATE BOOL32                  gbEventUse[FSR_OAM_MAX_EVENTS] = {FALSE32,};
+PRIVATE DEFINE_SPINLOCK(gEventLock);    /* protects gbEventUse[]          */
+
+/* software DMA engine : one outstanding transfer per event */
+PRIVATE struct workqueue_struct *gpstDMAWq = NULL;
+PRIVATE FsrDMAReq               gstDMAReq[FSR_OAM_MAX_EVENTS];
+
 #if defined(FSR_USE_DUAL_CORE)
 PRIVATE     UINT32          gnShMemBaseAddress[FSR_MAX_VOLS]    = {0x0,0};
 PRIVATE     UINT32          gnShMemMaxSize[FSR_MAX_VOLS]        = {0x0,0};
@@ -967,8 +988,31 @@ FSR_OAM_ClrNEnableInt(UINT32  nLogIntId)
 PUBLIC BOOL32
 FSR_OAM_CreateEvent(UINT32    *pHandle)
 {
-    /* should be implemented */
-    return TRUE32;
+    UINT32      nIdx;
+    BOOL32      bRe = FALSE32;
+
+    FSR_STACK_VAR;
+
+    FSR_STACK_END;
+
+    spin_lock(&gEventLock);
+
+    for (nIdx = 0; nIdx < FSR_OAM_MAX_EVENTS; nIdx++)
+    {
+        if (gbEventUse[nIdx] == FALSE32)
+        {
+            gbEventUse[nIdx] = TRUE32;
+            init_completion(&gstEvent[nIdx]);
+
+            *pHandle = nIdx;
+            bRe      = TRUE32;
+            break;
+        }
+    }
+
+    spin_unlock(&gEventLock);
+
+    return bRe;
 }
 
 /**
@@ -987,8 +1031,28 @@ FSR_OAM_CreateEvent(UINT32    *pHandle)
 PUBLIC BOOL32
 FSR_OAM_DeleteEvent(UINT32     nHandle)
 {
-    /* should be implemented */
-    return TRUE32;
+    BOOL32      bRe = FALSE32;
+
+    FSR_STACK_VAR;
+
+    FSR_STACK_END;
+
+    if (nHandle >= FSR_OAM_MAX_EVENTS)
+    {
+        return FALSE32;
+    }
+
+    spin_lock(&gEventLock);
+
+    if (gbEventUse[nHandle] == TRUE32)
+    {
+        gbEventUse[nHandle] = FALSE32;
+        bRe                 = TRUE32;
+    }
+
+    spin_unlock(&gEventLock);
+
+    return bRe;
 }
 
 /**
@@ -1007,7 +1071,17 @@ FSR_OAM_DeleteEvent(UINT32     nHandle)
 PUBLIC BOOL32
 FSR_OAM_SendEvent(UINT32     nHandle)
 {
-    /* should be implemented */
+    FSR_STACK_VAR;
+
+    FSR_STACK_END;
+
+    if ((nHandle >= FSR_OAM_MAX_EVENTS) || (gbEventUse[nHandle] == FALSE32))
+    {
+        return FALSE32;
+    }
+
+    complete(&gstEvent[nHandle]);
+
     return TRUE32;
 }
 
@@ -1027,7 +1101,17 @@ FSR_OAM_SendEvent(UINT32     nHandle)
 PUBLIC BOOL32
 FSR_OAM_ReceiveEvent(UINT32     nHandle)
 {
-    /* should be implemented */
+    FSR_STACK_VAR;
+
+    FSR_STACK_END;
+
+    if ((nHandle >= FSR_OAM_MAX_EVENTS) || (gbEventUse[nHandle] == FALSE32))
+    {
+        return FALSE32;
+    }
+
+    wait_for_completion(&gstEvent[nHandle]);
+
     return TRUE32;
 }
 
@@ -1124,6 +1208,13 @@ FSR_OAM_InitDMA(VOID)
 
     /* initializes DMA registers */
 
+    /* there is no DMA controller to program,
+     * transfers are run by the software DMA engine */
+    if (gpstDMAWq == NULL)
+    {
+        gpstDMAWq = create_singlethread_workqueue("fsr_dma");
+    }
+
     return FSR_OAM_SUCCESS;
 }
 
@@ -1180,3 +1271,142 @@ FSR_OAM_WriteDMA(UINT32     nVirDstAddr,
 
     return FSR_OAM_SUCCESS;
 }
+
+/**
+ * @brief           This function runs a transfer queued to the software DMA engine
+ *
+ * @param[in]      *pstWork : work item of FsrDMAReq
+ *
+ * @return          none
+ *
+ * @remark          the event of the request is sent when the copy is done
+ *
+ */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 20)
+PRIVATE VOID
+_RunDMA(struct work_struct *pstWork)
+{
+    FsrDMAReq  *pstReq = container_of(pstWork, FsrDMAReq, stWork);
+#else
+PRIVATE VOID
+_RunDMA(VOID *pData)
+{
+    FsrDMAReq  *pstReq = (FsrDMAReq *) pData;
+#endif
+
+    memcpy32((void *) pstReq->nDstAddr, (void *) pstReq->nSrcAddr, pstReq->nSize);
+
+    FSR_OAM_SendEvent(pstReq->nEvent);
+}
+
+/**
+ * @brief           This function queues a transfer to the software DMA engine
+ *
+ * @param[in]       nVirDstAddr : virtual destination address
+ * @param[in]       nVirSrcAddr : virtual source address
+ * @param[in]       nSize       : size to be transferred
+ * @param[in]       nEvent      : event handle sent on completion
+ *
+ * @return          FSR_OAM_SUCCESS
+ * @return          FSR_OAM_CRITICAL_ERROR
+ *
+ * @remark          if FSR_OAM_InitDMA() has not created the engine,
+ *                  the copy is done in place and the event is sent at once
+ *
+ */
+PRIVATE INT32
+_SubmitDMA(UINT32     nVirDstAddr,
+           UINT32     nVirSrcAddr,
+           UINT32     nSize,
+           UINT32     nEvent)
+{
+    FsrDMAReq  *pstReq;
+
+    if ((nEvent >= FSR_OAM_MAX_EVENTS) || (gbEventUse[nEvent] == FALSE32))
+    {
+        return FSR_OAM_CRITICAL_ERROR;
+    }
+
+    if (gpstDMAWq == NULL)
+    {
+        memcpy32((void *) nVirDstAddr, (void *) nVirSrcAddr, nSize);
+        FSR_OAM_SendEvent(nEvent);
+        return FSR_OAM_SUCCESS;
+    }
+
+    pstReq           = &gstDMAReq[nEvent];
+    pstReq->nDstAddr = nVirDstAddr;
+    pstReq->nSrcAddr = nVirSrcAddr;
+    pstReq->nSize    = nSize;
+    pstReq->nEvent   = nEvent;
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 20)
+    INIT_WORK(&pstReq->stWork, _RunDMA);
+#else
+    INIT_WORK(&pstReq->stWork, _RunDMA, pstReq);
+#endif
+
+    queue_work(gpstDMAWq, &pstReq->stWork);
+
+    return FSR_OAM_SUCCESS;
+}
+
+/**
+ * @brief           This function starts read operation by DMA
+ *                  and returns without waiting for its completion
+ *
+ * @param[in]       nVirDstAddr : virtual destination address
+ * @param[in]       nVirSrcAddr : virtual source address
+ * @param[in]       nSize       : size to be transferred
+ * @param[in]       nEvent      : event handle sent on completion
+ *
+ * @return          FSR_OAM_SUCCESS
+ * @return          FSR_OAM_CRITICAL_ERROR
+ *
+ * @remark          the caller must not touch both buffers until
+ *                  FSR_OAM_ReceiveEvent(nEvent) returns.
+ *                  only one transfer may be outstanding per event.
+ *
+ */
+PUBLIC INT32
+FSR_OAM_ReadDMAAsync(UINT32     nVirDstAddr,
+                     UINT32     nVirSrcAddr,
+                     UINT32     nSize,
+                     UINT32     nEvent)
+{
+    FSR_STACK_VAR;
+
+    FSR_STACK_END;
+
+    return _SubmitDMA(nVirDstAddr, nVirSrcAddr, nSize, nEvent);
+}
+
+/**
+ * @brief           This function starts write operation by DMA
+ *                  and returns without waiting for its completion
+ *
+ * @param[in]       nVirDstAddr : virtual destination address
+ * @param[in]       nVirSrcAddr : virtual source address
+ * @param[in]       nSize       : size to be transferred
+ * @param[in]       nEvent      : event handle sent on completion
+ *
+ * @return          FSR_OAM_SUCCESS
+ * @return          FSR_OAM_CRITICAL_ERROR
+ *
+ * @remark          the caller must not touch both buffers until
+ *                  FSR_OAM_ReceiveEvent(nEvent) returns.
+ *                  only one transfer may be outstanding per event.
+ *
+ */
+PUBLIC INT32
+FSR_OAM_WriteDMAAsync(UINT32     nVirDstAddr,
+                      UINT32     nVirSrcAddr,
+                      UINT32     nSize,
+                      UINT32     nEvent)
+{
+    FSR_STACK_VAR;
+
+    FSR_STACK_END;
+
+    return _SubmitDMA(nVirDstAddr, nVirSrcAddr, nSize, nEvent);
+}
@@ -175,6 +175,8 @@ PRIVATE BOOL32                  gbPAMInit                   = FALSE32;
 PRIVATE BOOL32                  gbFlexOneNAND[FSR_MAX_VOLS] = {FALSE32, FALSE32};
 PRIVATE BOOL32                  gbUseWriteDMA               = FALSE32;
 PRIVATE BOOL32                  gbUseReadDMA                = FALSE32;
+PRIVATE BOOL32                  gbDMAEvent                  = FALSE32;
+PRIVATE UINT32                  gnDMAEvent                  = 0;
 #if defined(FSR_ENABLE_ONENAND_LFT)
 PRIVATE volatile OneNANDReg     *gpOneNANDReg               = (volatile OneNANDReg *) 0;
 #elif defined(FSR_ENABLE_FLEXOND_LFT)
@@ -247,6 +249,12 @@ FSR_PAM_Init(VOID)
         gbUseReadDMA  = FALSE32;
 #endif
 
+        /* completion event of the asynchronous DMA in _TransByDMA() */
+        if ((gbUseWriteDMA == TRUE32) || (gbUseReadDMA == TRUE32))
+        {
+            gbDMAEvent = FSR_OAM_CreateEvent(&gnDMAEvent);
+        }
+
 #if defined(FSR_WINCE_OAM)
         /* For WCE/WM, FSR_OAM_Pa2Va does nothing. */
         if (((UINT32)CheckMMU()) & 0x01)
@@ -504,6 +512,68 @@ FSR_PAM_RegLFT(FSRLowFuncTbl  *pstLFT[FSR_MAX_VOLS])
     return FSR_PAM_SUCCESS;
 }
 
+/**
+ * @brief           This function transfers data by DMA
+ *
+ * @param[in]       nDst   : destination address
+ * @param[in]       nSrc   : source address
+ * @param[in]       nSize  : length to be transferred
+ * @param[in]       bWrite : TRUE32 for a transfer to NAND
+ *
+ * @return          none
+ *
+ * @remark          the first half is started by DMA and the CPU copies the
+ *                  second half meanwhile. the function returns when both
+ *                  are done. every caller holds the BML semaphore, which is
+ *                  shared by all volumes, so one event is enough.
+ *
+ */
+PRIVATE VOID
+_TransByDMA(UINT32  nDst,
+            UINT32  nSrc,
+            UINT32  nSize,
+            BOOL32  bWrite)
+{
+    UINT32      nHalf;
+    INT32       nOAMRe = FSR_OAM_CRITICAL_ERROR;
+
+    FSR_STACK_VAR;
+
+    FSR_STACK_END;
+
+    /* keep both halves word aligned for memcpy32 */
+    nHalf = (nSize / 2) & ~0x03;
+
+    if (gbDMAEvent == TRUE32)
+    {
+        if (bWrite == TRUE32)
+        {
+            nOAMRe = FSR_OAM_WriteDMAAsync(nDst, nSrc, nHalf, gnDMAEvent);
+        }
+        else
+        {
+            nOAMRe = FSR_OAM_ReadDMAAsync(nDst, nSrc, nHalf, gnDMAEvent);
+        }
+    }
+
+    if (nOAMRe != FSR_OAM_SUCCESS)
+    {
+        if (bWrite == TRUE32)
+        {
+            FSR_OAM_WriteDMA(nDst, nSrc, nSize);
+        }
+        else
+        {
+            FSR_OAM_ReadDMA(nDst, nSrc, nSize);
+        }
+        return;
+    }
+
+    memcpy32((void *) (nDst + nHalf), (void *) (nSrc + nHalf), nSize - nHalf);
+
+    FSR_OAM_ReceiveEvent(gnDMAEvent);
+}
+
 /**
  * @brief           This function transfers data to NAND
  *
@@ -538,7 +608,7 @@ FSR_PAM_TransToNAND(volatile VOID *pDst,
     {
         if (gbUseWriteDMA == TRUE32)
         {
-            FSR_OAM_WriteDMA((UINT32) pDst, (UINT32) pSrc, nSize);
+            _TransByDMA((UINT32) pDst, (UINT32) pSrc, nSize, TRUE32);
         }
         else
         {
@@ -585,7 +655,7 @@ FSR_PAM_TransFromNAND(VOID          *pDst,
     {
         if (gbUseReadDMA == TRUE32)
         {
-            FSR_OAM_ReadDMA((UINT32) pDst, (UINT32) pSrc, nSize);
+            _TransByDMA((UINT32) pDst, (UINT32) pSrc, nSize, FALSE32);
         }
         else
         {
@@ -1,5 +1,7 @@
 #include <FSR.h>
 
+/* built only when CONFIG_ARM is not set. ARM kernels link memcpy32 of
+ * FSR_PAM_asm.S, which already moves 32 bytes per ldm/stm pair */
 VOID    memcpy32 (VOID       *pDst,
                   VOID       *pSrc,
                   UINT32     nSize)
@@ -13,7 +15,29 @@ VOID    memcpy32 (VOID       *pDst,
 	pDst32  = (UINT32 *)(pDst);
 	nSize32 = nSize / sizeof (UINT32);
 
-	for(index = 0; index < nSize32; index++)
+	/* copy 8 words per burst so that the compiler can use ldm/stm */
+	for(index = 0; index < (nSize32 & ~0x7); index += 8)
+	{
+		UINT32 nW0 = pSrc32[index + 0];
+		UINT32 nW1 = pSrc32[index + 1];
+		UINT32 nW2 = pSrc32[index + 2];
+		UINT32 nW3 = pSrc32[index + 3];
+		UINT32 nW4 = pSrc32[index + 4];
+		UINT32 nW5 = pSrc32[index + 5];
+		UINT32 nW6 = pSrc32[index + 6];
+		UINT32 nW7 = pSrc32[index + 7];
+
+		pDst32[index + 0] = nW0;
+		pDst32[index + 1] = nW1;
+		pDst32[index + 2] = nW2;
+		pDst32[index + 3] = nW3;
+		pDst32[index + 4] = nW4;
+		pDst32[index + 5] = nW5;
+		pDst32[index + 6] = nW6;
+		pDst32[index + 7] = nW7;
+	}
+
+	for(; index < nSize32; index++)
 	{
 		pDst32[index] = pSrc32[index];
 	}
@@ -46,6 +46,10 @@
  *
  * @return          none
  *
+ * @remark          built only when CONFIG_ARM is not set. ARM kernels link
+ * @n               memcpy32 of FSR_PAM_asm.S, which already moves 32 bytes
+ * @n               per ldm/stm pair and handles unaligned buffers.
+ *
  * @author          SongHo Yoon
  * @version         1.0.0
  *
@@ -59,14 +63,42 @@ memcpy32 (VOID       *pDst,
     UINT32  *pSrc32;
     UINT32  *pDst32;
     UINT32   nSize32;
+    UINT32   nW0, nW1, nW2, nW3, nW4, nW5, nW6, nW7;
 
 
     pSrc32  = (UINT32 *)(pSrc);
     pDst32  = (UINT32 *)(pDst);
     nSize32 = nSize / sizeof (UINT32);
 
-    for(nIdx = 0; nIdx < nSize32; nIdx++)
+    /* copy 8 words per burst; all loads are issued before the stores
+     * so that the compiler can use multiple load/store instructions */
+    for(nIdx = nSize32 >> 3; nIdx > 0; nIdx--)
+    {
+        nW0 = pSrc32[0];
+        nW1 = pSrc32[1];
+        nW2 = pSrc32[2];
+        nW3 = pSrc32[3];
+        nW4 = pSrc32[4];
+        nW5 = pSrc32[5];
+        nW6 = pSrc32[6];
+        nW7 = pSrc32[7];
+
+        pDst32[0] = nW0;
+        pDst32[1] = nW1;
+        pDst32[2] = nW2;
+        pDst32[3] = nW3;
+        pDst32[4] = nW4;
+        pDst32[5] = nW5;
+        pDst32[6] = nW6;
+        pDst32[7] = nW7;
+
+        pSrc32 += 8;
+        pDst32 += 8;
+    }
+
+    /* copy remaining words (spare area is 16 bytes per sector) */
+    for(nIdx = nSize32 & 0x7; nIdx > 0; nIdx--)
     {
-        pDst32[nIdx] = pSrc32[nIdx];
+        *pDst32++ = *pSrc32++;
     }
 }
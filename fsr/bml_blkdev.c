@@ -30,6 +30,7 @@
 #include <linux/init.h>
 #include <linux/fs.h>
 #include <linux/version.h>
+#include <linux/crc32.h>
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 15)
 #include <linux/platform_device.h>
 #else
@@ -58,8 +59,212 @@ extern int (*bml_module_resume)(struct device *dev, u32 level);
 #endif
 #endif /* CONFIG_RFS_FSR */
 
+/**
+ * check whether a page holds nothing but 0xFF
+ * @param buf			: page buffer
+ * @param size			: page size in bytes
+ * @return			1 if the page is erased data, 0 otherwise
+ */
+static int bml_page_erased(const char *buf, u32 size)
+{
+	const unsigned long *p = (const unsigned long *) buf;
+	u32 i;
+
+	for (i = 0; i < size / sizeof(unsigned long); i++)
+	{
+		if (p[i] != ~0UL)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+/**
+ * write pages in streaming image write mode
+ * @param dev			: bml block device
+ * @param volume		: device number
+ * @param partno		: partition number
+ * @param sector		: start sector in the partition
+ * @param nsect			: number of sectors
+ * @param buf			: data to write
+ * @return			FSR_BML_SUCCESS on success, BML error otherwise
+ *
+ * Units are erased one ahead of the data. FSR_BML_Erase returns once
+ * the erase is issued, so it runs while the next request is prepared.
+ * Pages of 0xFF are left erased and the remaining runs are written
+ * with one FSR_BML_Write each, which lets BML use cache and multi-plane
+ * program. The crc32 is computed over the data as it is written, and
+ * the program status reported by the LLD is the only verification.
+ * The partition must be written sequentially, a request that does not
+ * start at the next sector is rejected.
+ */
+static int bml_stream_write(struct fsr_dev *dev, u32 volume, u32 partno,
+			unsigned long sector, unsigned long nsect, char *buf)
+{
+	FSRVolSpec *vs;
+	FSRPartI *ps;
+	u32 spp_shift, spu_shift, psize, page, npages, last_unit, nr_units;
+	u32 vun, i, start = 0, run = 0;
+	int ret;
+
+	if (sector != dev->stream_next)
+	{
+		ERRPRINTK("BML: stream write out of order, sector %lu (expected %u)\n",
+			sector, dev->stream_next);
+		return FSR_BML_INVALID_PARAM;
+	}
+
+	vs = fsr_get_vol_spec(volume);
+	ps = fsr_get_part_spec(volume);
+	spp_shift = ffs(vs->nSctsPerPg) - 1;
+	spu_shift = ffs(dev->stream_pgs_unit * vs->nSctsPerPg) - 1;
+	psize = vs->nSctsPerPg << SECTOR_BITS;
+
+	last_unit = (sector + nsect - 1) >> spu_shift;
+	nr_units = fsr_part_units_nr(ps, partno);
+
+	while (dev->stream_erased <= last_unit + 1 &&
+		dev->stream_erased < nr_units)
+	{
+		vun = fsr_part_start(ps, partno) + dev->stream_erased;
+		ret = FSR_BML_Erase(volume, &vun, 1, FSR_BML_FLAG_NONE);
+		if (ret != FSR_BML_SUCCESS)
+		{
+			ERRPRINTK("BML: Erase error = %X\n", ret);
+			return ret;
+		}
+
+		dev->stream_erased++;
+	}
+
+	page = sector >> spp_shift;
+	npages = nsect >> spp_shift;
+
+	for (i = 0; i <= npages; i++)
+	{
+		if (i < npages)
+		{
+			/* erased pages are part of the image, so they count too */
+			dev->stream_crc = crc32_le(dev->stream_crc,
+					buf + i * psize, psize);
+
+			if (!bml_page_erased(buf + i * psize, psize))
+			{
+				if (run++ == 0)
+				{
+					start = i;
+				}
+				continue;
+			}
+		}
+
+		if (run)
+		{
+			ret = FSR_BML_Write(volume, dev->stream_1st_vpn + page + start,
+					run, buf + start * psize, NULL, FSR_BML_FLAG_ECC_ON);
+			if (ret != FSR_BML_SUCCESS)
+			{
+				return ret;
+			}
+			run = 0;
+		}
+	}
+
+	dev->stream_next = sector + nsect;
+
+	return FSR_BML_SUCCESS;
+}
+
+/**
+ * turn streaming image write mode on or off
+ * @param minor			: minor number of the partition
+ * @param cmd			: BML_STREAM_BEGIN or BML_STREAM_END
+ * @param crc			: crc32 of the data written since BML_STREAM_BEGIN
+ *				  (BML_STREAM_END only)
+ * @return			0 on success, otherwise on failure
+ *
+ * The stream state is changed under fsr_mutex, which bml_transfer()
+ * holds for a whole streamed write.
+ */
+int bml_stream_ctl(u32 minor, u32 cmd, u32 *crc)
+{
+	struct fsr_dev *dev = NULL, *cur;
+	struct list_head *this;
+	u32 volume = fsr_vol(minor), partno = fsr_part(minor);
+	u32 n1stVpn, nPgsPerUnit;
+	int ret;
+
+	if (fsr_is_whole_dev(partno))
+	{
+		return -EINVAL;
+	}
+
+	down(&bml_list_mutex);
+	list_for_each(this, &bml_list)
+	{
+		cur = list_entry(this, struct fsr_dev, list);
+		if (cur->gd && cur->gd->first_minor == minor)
+		{
+			dev = cur;
+			break;
+		}
+	}
+	up(&bml_list_mutex);
+
+	if (!dev)
+	{
+		return -ENODEV;
+	}
+
+	if (cmd == BML_STREAM_BEGIN)
+	{
+		if (FSR_BML_GetVirUnitInfo(volume,
+			fsr_part_start(fsr_get_part_spec(volume), partno),
+			&n1stVpn, &nPgsPerUnit) != FSR_BML_SUCCESS)
+		{
+			ERRPRINTK("FSR_BML_GetVirUnitInfo FAIL\n");
+			return -EIO;
+		}
+
+		FSR_DOWN(&fsr_mutex);
+		dev->stream_1st_vpn = n1stVpn;
+		dev->stream_pgs_unit = nPgsPerUnit;
+		dev->stream_erased = 0;
+		dev->stream_next = 0;
+		dev->stream_crc = ~0U;
+		dev->stream = 1;
+		FSR_UP(&fsr_mutex);
+
+		return 0;
+	}
+
+	FSR_DOWN(&fsr_mutex);
+	if (!dev->stream)
+	{
+		FSR_UP(&fsr_mutex);
+		return -EINVAL;
+	}
+
+	dev->stream = 0;
+	*crc = dev->stream_crc ^ ~0U;
+
+	/* complete the erases and programs still in flight */
+	ret = FSR_BML_FlushOp(volume, FSR_BML_FLAG_NONE);
+	FSR_UP(&fsr_mutex);
+	if (ret != FSR_BML_SUCCESS)
+	{
+		ERRPRINTK("BML: FSR_BML_FlushOp fail, volume(%d)[0x%x]", volume, ret);
+		return -EIO;
+	}
+
+	return 0;
+}
+
 /**
  * transger data from BML to buffer cache
+ * @param dev			: bml block device
  * @param volume		: device number
  * @param partno		: 0~15: partition, other: whole device
  * @param req			: request description
@@ -67,7 +272,8 @@ extern int (*bml_module_resume)(struct device *dev, u32 level);
  *
  * It will erase a block before it do write the data
  */
-static int bml_transfer(u32 volume, u32 partno, const struct request *req)
+static int bml_transfer(struct fsr_dev *dev, u32 volume, u32 partno,
+			const struct request *req)
 {
 	unsigned long sector, nsect;
 	char *buf;
@@ -75,6 +281,7 @@ static int bml_transfer(u32 volume, u32 partno, const struct request *req)
 	FSRPartI *ps;
 	u32 nPgsPerUnit = 0, n1stVpn = 0, vun = 0, vsn = 0;
 	u32 spu_shift, spp_shift, spp_mask;
+	int stream = 0;
 	int ret;
 
 	DEBUG(DL3,"BML[I] volume(%d), partno(%d)\n",volume, partno);
@@ -98,8 +305,24 @@ static int bml_transfer(u32 volume, u32 partno, const struct request *req)
 	 *  Check the partition attr. and erase the partition. when command is WRITE
 	 */
 
+	// a streamed write holds fsr_mutex, so BML_STREAM_END waits for it
+	if (rq_data_dir(req) == WRITE)
+	{
+		FSR_DOWN(&fsr_mutex);
+		stream = dev->stream;
+		if (!stream)
+		{
+			FSR_UP(&fsr_mutex);
+		}
+	}
+
+	// streaming image write, units are erased by bml_stream_write()
+	if (stream)
+	{
+		n1stVpn = dev->stream_1st_vpn;
+	}
 	// partial partition
-	if(likely(!fsr_is_whole_dev(partno)))
+	else if(likely(!fsr_is_whole_dev(partno)))
 	{
 		if (FSR_BML_GetVirUnitInfo(volume, fsr_part_start(ps, partno),
 					&n1stVpn, &nPgsPerUnit) != FSR_BML_SUCCESS)
@@ -150,20 +373,12 @@ static int bml_transfer(u32 volume, u32 partno, const struct request *req)
 		// only if command is WRITE and meet ther first sector of volume 
 		if (rq_data_dir(req) == WRITE && sector == 0)
 		{
-			u32 start_unit = 0, end_unit = fsr_vol_unit_nr(vs);
-
-			while (start_unit < end_unit)
+			ret = fsr_erase_units(volume, 0, fsr_vol_unit_nr(vs));
+			/* I/O error */
+			if (ret != FSR_BML_SUCCESS)
 			{
-				ret = FSR_BML_Erase(volume, &start_unit, 1, 
-									FSR_BML_FLAG_NONE);
-				/* I/O error */
-				if (ret != FSR_BML_SUCCESS)
-				{
-					ERRPRINTK("FSR_BML_Erase Fail : %x", ret);
-					return -EIO;
-				}
-
-				++start_unit;
+				ERRPRINTK("FSR_BML_Erase Fail : %x", ret);
+				return -EIO;
 			}
 		}
 	}
@@ -190,8 +405,16 @@ static int bml_transfer(u32 volume, u32 partno, const struct request *req)
 		break;
 
 		case WRITE:
+		if (stream)
+		{
+			ret = bml_stream_write(dev, volume, partno, sector, nsect, buf);
+			FSR_UP(&fsr_mutex);
+		}
+		else
+		{
 			ret = FSR_BML_Write(volume, n1stVpn + (sector >> spp_shift), 
 					nsect >> spp_shift, buf, NULL, FSR_BML_FLAG_ECC_ON);	
+		}
 		break;
 
 		default:
@@ -263,7 +486,7 @@ static void bml_request(struct request_queue *rq)
 			}
 		}
 		
-		trans_ret = bml_transfer(volume, partno, req);
+		trans_ret = bml_transfer(dev, volume, partno, req);
 		
 		spin_lock_irq(rq->queue_lock);
 
@@ -233,20 +233,12 @@ static int bml_dump_from_user(u32 cmd, u32 volume, u32 partno, PAGEINFO_T *user_
 			{
 				if (page == 0)
 				{
-					u32 start_unit = 0, end_unit = fsr_vol_unit_nr(vs);
-
-					while (start_unit < end_unit)
+					ret = fsr_erase_units(volume, 0, fsr_vol_unit_nr(vs));
+					/* I/O error */
+					if (ret != FSR_BML_SUCCESS)
 					{
-						ret = FSR_BML_Erase(volume, &start_unit, 1,
-											FSR_BML_FLAG_NONE);
-						/* I/O error */
-						if (ret != FSR_BML_SUCCESS)
-						{
-							ERRPRINTK("FSR_BML_Erase Fail [0x%08x]", ret);
-							return -EIO;
-						}
-
-						++start_unit;
+						ERRPRINTK("FSR_BML_Erase Fail [0x%08x]", ret);
+						return -EIO;
 					}
 				}
 			}
@@ -776,18 +768,12 @@ static int bml_block_ioctl(struct inode *inode, struct file *file,
 				end_unit = start_unit + fsr_part_units_nr(pi, partno);
 			}
 			
-			while(start_unit < end_unit)
+			ret = fsr_erase_units(volume, start_unit, end_unit - start_unit);
+			/* I/O error */
+			if (ret != FSR_BML_SUCCESS)
 			{
-				ret = FSR_BML_Erase(volume, &start_unit, 1, 
-									FSR_BML_FLAG_NONE);
-				/* I/O error */
-				if (ret != FSR_BML_SUCCESS)
-				{
-					ERRPRINTK("FSR_BML_Erase Fail : %x, volume : %d, start unit : %d", ret, volume, start_unit);
-					return -EIO;
-				}
-	
-				++start_unit;
+				ERRPRINTK("FSR_BML_Erase Fail : %x, volume : %d, units : %d ~ %d", ret, volume, start_unit, end_unit - 1);
+				return -EIO;
 			}
 			
 			DEBUG(DL3, "OUT BML_ERASE : 0x%x\n", cmd);
@@ -891,6 +877,28 @@ static int bml_block_ioctl(struct inode *inode, struct file *file,
 			return 0;
 		}
 
+		case BML_STREAM_BEGIN:
+		case BML_STREAM_END:
+		{
+			u32 crc = 0;
+
+			ret = bml_stream_ctl(minor, cmd, &crc);
+			if (ret)
+			{
+				ERRPRINTK("bml_stream_ctl fail : %d, cmd : 0x%x", ret, cmd);
+				return ret;
+			}
+
+			if (cmd == BML_STREAM_END &&
+				copy_to_user((char *) arg, (char *) &crc, sizeof (u32)))
+			{
+				ERRPRINTK("copy_to_user error");
+				return -EFAULT;
+			}
+
+			return 0;
+		}
+
 		case BML_OTP_READ:
 		case BML_OTP_WRITE:
 		{
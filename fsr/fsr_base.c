@@ -53,6 +53,8 @@ EXPORT_SYMBOL(fsr_proc_dir);
 #ifndef CONFIG_TINY_FSR
 	int (*sec_stl_delete)(dev_t dev, u32 start, u32 nums, u32 b_size) = NULL;
 	EXPORT_SYMBOL(sec_stl_delete);
+	int (*sec_stl_delete_ext)(dev_t dev, STL_DELETE_EXTENT_T *ext, u32 nr_ext, u32 b_size) = NULL;
+	EXPORT_SYMBOL(sec_stl_delete_ext);
 #endif
 
 /* To protect fsr operations, this semaphore lock fsr codes */
@@ -186,6 +188,41 @@ int fsr_read_partitions(u32 volume, BML_PARTTAB_T *parttab)
 	return 0;
 }
 
+/**
+ * fsr_erase_units - erase consecutive units of a volume in batches
+ * @param volume        : a volume number
+ * @param start_unit    : the first unit to erase
+ * @param nr_units      : the number of units to erase
+ * @return              FSR_BML_SUCCESS or the error of FSR_BML_Erase
+ *
+ * Several units are passed to each FSR_BML_Erase call. BML still takes
+ * its semaphore unit by unit, so other users are not locked out while a
+ * whole partition is erased. Within a call each die is flushed only
+ * before its first erase, so the erase of one die runs while the next
+ * die is issued.
+ */
+int fsr_erase_units(u32 volume, u32 start_unit, u32 nr_units)
+{
+	u32 units[FSR_ERASE_BATCH];
+	u32 nr, i;
+	int ret = FSR_BML_SUCCESS;
+
+	while (nr_units) {
+		nr = (nr_units > FSR_ERASE_BATCH) ? FSR_ERASE_BATCH : nr_units;
+		for (i = 0; i < nr; i++)
+			units[i] = start_unit + i;
+
+		ret = FSR_BML_Erase(volume, units, nr, FSR_BML_FLAG_NONE);
+		if (ret != FSR_BML_SUCCESS)
+			break;
+
+		start_unit += nr;
+		nr_units -= nr;
+	}
+
+	return ret;
+}
+
 /**
  * fsr_write_partitions - write partition table into the device
  * @param volume        : a volume number
@@ -471,6 +508,7 @@ EXPORT_SYMBOL(fsr_get_part_spec);
 EXPORT_SYMBOL(fsr_get_vol_spec);
 EXPORT_SYMBOL(fsr_get_stl_info);
 EXPORT_SYMBOL(fsr_update_vol_spec);
+EXPORT_SYMBOL(fsr_erase_units);
 
 /* OAM */
 EXPORT_SYMBOL(FSR_OAM_Malloc);
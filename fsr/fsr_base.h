@@ -77,6 +77,7 @@
 #define OOB_BITS		4
 #define SECTOR_MASK             MASK(SECTOR_BITS)
 #define MAX_LEN_PARTITIONS	(sizeof(FSRPartI))
+#define FSR_ERASE_BATCH		16	/* units per FSR_BML_Erase call */
 
 #ifdef CONFIG_PROC_FS
 	extern struct proc_dir_entry *fsr_proc_dir;
@@ -88,6 +89,7 @@
 
 extern struct semaphore fsr_mutex;
 extern int (*sec_stl_delete)(dev_t dev, u32 start, u32 nums, u32 b_size);
+extern int (*sec_stl_delete_ext)(dev_t dev, STL_DELETE_EXTENT_T *ext, u32 nr_ext, u32 b_size);
 
 FSRVolSpec *fsr_get_vol_spec(u32 volume);
 FSRPartI   *fsr_get_part_spec(u32 volume);
@@ -256,6 +258,7 @@ FSRLowFuncTbl* fsr_get_low_tbl(u32 volume);
 
 int fsr_init_partition(u32 volume);
 int fsr_update_vol_spec(u32 volume);
+int fsr_erase_units(u32 volume, u32 start_unit, u32 nr_units);
 int fsr_write_partitions(u32 volume, BML_PARTTAB_T *parttab);
 int fsr_read_partitions(u32 volume, BML_PARTTAB_T *parttab);
 struct block_device_operations *bml_get_block_device_operations(void);
@@ -265,6 +268,7 @@ void fsr_register_stl_ioctl(int (*func) (u32, u32, u32, u32));
 void fsr_unregister_stl_ioctl(void);
 
 int bml_update_blkdev_param(u32 minor, u32 blkdev_size, u32 blkdev_blksize);
+int bml_stream_ctl(u32 minor, u32 cmd, u32 *crc);
 int stl_update_blkdev_param(u32 minor, u32 blkdev_size, u32 blkdev_blksize);
 stl_info_t *fsr_get_stl_info(u32 volume, u32 partno);
 struct block_device_operations *stl_get_block_device_operations(void);
@@ -306,6 +310,14 @@ struct fsr_dev
 	struct gendisk          *gd;
 	int			dev_id;
 	struct scatterlist	*sg;
+
+	/* streaming image write (BML_STREAM_BEGIN/END) */
+	int			stream;		/* streaming write mode is on */
+	u32			stream_1st_vpn;	/* first vpn of the partition */
+	u32			stream_pgs_unit;/* pages per unit */
+	u32			stream_erased;	/* # of units erased ahead */
+	u32			stream_next;	/* next sector to be written */
+	u32			stream_crc;	/* running crc32 of written data */
 };
 #else
 /* Kernel 2.4 */
@@ -48,6 +48,7 @@
 #include <linux/module.h>
 #include <linux/init.h>
 #include <linux/slab.h>
+#include <asm/div64.h>
 
 #include "fsr_base.h"
 
@@ -58,6 +59,8 @@
 #define USEC_PER_SEC 1000000L
 #endif
 #define FLOAT_POSITION 1000
+/* main and spare area of a 4KB page, the unit the LLDs move to the DataRAM */
+#define COPY_SIZE	(4096 + 128)
 #define BML	0
 #define STL	1
 
@@ -84,12 +87,21 @@ static u32 minor = 0; /* minor number */
 static u32 sectors = 0; /* number of sectors */
 static u32 rw = 2; /* 0: read, 1: write, otehrs; read/write */
 static u32 size = 0; /* size for operation*/
+static u32 mount = 0; /* number of BML open/close cycles to measure */
+static u32 rand_writes = 0; /* number of random STL writes to measure (0: none) */
+static u32 copy = 0; /* number of page copies to measure per copy routine (0: none) */
 
 module_param(major, int, 0644);
 module_param(minor, int, 0644);
 module_param(sectors, int, 0644);
 module_param(rw, int, 0644);
 module_param(size, int, 0644);
+module_param(mount, int, 0644);
+module_param(rand_writes, int, 0644);
+module_param(copy, int, 0644);
+
+/* page copy routine of the PAM (FSR_PAM_asm.S on ARM, FSR_PAM_Memcpy.c otherwise) */
+extern VOID memcpy32(VOID *pDst, VOID *pSrc, UINT32 nSize);
 
 /**
  * calibrate_performance - calibrate a performance of operation
@@ -210,6 +222,95 @@ static u32 get_performance(struct performance_input dev_input, int write)
 	return calibrate_performance(start_time, stop_time, datasize_kbytes);
 }
 
+/**
+ * get_random_performance - measure random write IOPS and write amplification of STL
+ * @param dev_input	input values to do operation
+ * @return		0 on success
+ * Requests of 'sectors' size are written at pseudo random aligned offsets 
+ * with a fixed seed, so that runs on the same partition are comparable.
+ * Write amplification needs OP_SUPPORT_WA_STATS in the STL.
+ */
+static int get_random_performance(struct performance_input dev_input)
+{
+	struct timeval start_time, stop_time;
+	static const char *cause_names[FSR_STL_WA_CAUSES] = 
+		{"user", "merge", "compact", "wl", "gc", "meta", "wbuf"};
+	FSRStlWAStats stats;
+	u32 slots, count, seed = 1, interval_msec, iops, len, pgs, cause;
+	u64 wa;
+	int ret, stats_ret;
+
+	slots = (dev_input.part_end_sector - dev_input.part_first_sector + 1) / sectors;
+	if (slots == 0)
+	{
+		return -EINVAL;
+	}
+
+	FSR_DOWN(&fsr_mutex);
+	stats_ret = FSR_STL_IOCtl(dev_input.volume, dev_input.part_id, 
+			FSR_STL_IOCTL_RESET_WA_STATS, NULL, 0, NULL, 0, &len);
+
+	do_gettimeofday(&start_time);
+	for (count = 0; count < rand_writes; count++)
+	{
+		/* linear congruential generator (Numerical Recipes) */
+		seed = seed * 1664525 + 1013904223;
+
+		ret = FSR_STL_Write(dev_input.volume, dev_input.part_id, 
+				dev_input.part_first_sector + (seed % slots) * sectors, 
+				sectors, dev_input.buf, FSR_STL_FLAG_USE_SM);
+		if (ret != FSR_STL_SUCCESS) 
+		{
+			FSR_UP(&fsr_mutex);
+			printk("stl: RANDOM WRITE transfer error = %x\n", ret);
+			return -EIO;
+		}
+	}
+	do_gettimeofday(&stop_time);
+
+	if (stats_ret == FSR_STL_SUCCESS)
+	{
+		stats_ret = FSR_STL_IOCtl(dev_input.volume, dev_input.part_id, 
+				FSR_STL_IOCTL_GET_WA_STATS, NULL, 0, &stats, sizeof(stats), &len);
+	}
+	FSR_UP(&fsr_mutex);
+
+	interval_msec = (stop_time.tv_sec - start_time.tv_sec) * MSEC_PER_SEC 
+		+ (stop_time.tv_usec - start_time.tv_usec) / MSEC_PER_SEC;
+	iops = (rand_writes * MSEC_PER_SEC) / (interval_msec ? interval_msec : 1);
+
+	printk("random write: %d requests of %d sectors, %d IOPS\n", 
+		rand_writes, sectors, iops);
+
+	if ((stats_ret == FSR_STL_SUCCESS) && (stats.nHostWrScts != 0))
+	{
+		pgs = 0;
+		for (cause = 0; cause < FSR_STL_WA_CAUSES; cause++)
+		{
+			pgs += stats.naPgmPgs[cause];
+		}
+
+		/* flash pages programmed per page written by the host */
+		wa = (u64)pgs * stats.nSctsPerPg * FLOAT_POSITION;
+		do_div(wa, stats.nHostWrScts);
+		printk("random write: WA %d.%03d (%d page programs)\n", 
+			(u32)wa / FLOAT_POSITION, (u32)wa % FLOAT_POSITION, pgs);
+
+		for (cause = 0; cause < FSR_STL_WA_CAUSES; cause++)
+		{
+			printk("random write:   %-8s %d pages, %d erases\n", 
+				cause_names[cause], 
+				stats.naPgmPgs[cause], stats.naErsBlks[cause]);
+		}
+	}
+	else
+	{
+		printk("random write: WA n/a (STL WA statistics are disabled)\n");
+	}
+
+	return 0;
+}
+
 /**
  * check_sectors - check error of sectors module parameter
  * return	0 on success
@@ -233,6 +334,168 @@ static int check_sectors(void)
 	return 0; /* sectors = 2, 4, 8, 16, 32, 64, 128 */
 }
 
+/**
+ * get_mount_time - measure the time of BML open (reservoir mount)
+ * @param volume	volume number
+ * @return		0 on success
+ * The first open after insmod is a cold mount. Following opens use the 
+ * checkpoint written by the previous close if it is still valid.
+ * The volume should not be opened by others (ex. mounted partition).
+ */
+static int get_mount_time(u32 volume)
+{
+	struct timeval start_time, stop_time;
+	u32 count, interval_usec, first_usec = 0, total_usec = 0;
+	FSRVolSpec vs;
+	int ret;
+
+	for (count = 0; count < mount; count++)
+	{
+		do_gettimeofday(&start_time);
+		ret = FSR_BML_Open(volume, FSR_BML_FLAG_NONE);
+		do_gettimeofday(&stop_time);
+		if (ret != FSR_BML_SUCCESS)
+		{
+			printk(KERN_ERR "BML: open error = %x\n", ret);
+			return -ENODEV;
+		}
+
+		interval_usec = (stop_time.tv_sec - start_time.tv_sec) * USEC_PER_SEC 
+			+ stop_time.tv_usec - start_time.tv_usec;
+
+		if (count == 0)
+		{
+			first_usec = interval_usec;
+			FSR_BML_GetVolSpec(volume, &vs, FSR_BML_FLAG_NONE);
+		}
+		total_usec += interval_usec;
+
+		FSR_BML_Close(volume, FSR_BML_FLAG_NONE);
+	}
+
+	printk("mount: volume %d, %d units, %d open/close cycles\n",
+		volume, vs.nNumOfUsUnits, mount);
+	printk("mount: first open %dus, average open %dus\n",
+		first_usec, total_usec / mount);
+
+	return 0;
+}
+
+/**
+ * copy_words - word by word copy, the former C memcpy32 of the PAM
+ * @param dst		destination buffer (word aligned)
+ * @param src		source buffer (word aligned)
+ * @param len		bytes to copy
+ */
+static void copy_words(void *dst, void *src, u32 len)
+{
+	u32 *dst32 = dst, *src32 = src;
+	u32 count;
+
+	for (count = 0; count < len / sizeof(u32); count++)
+	{
+		dst32[count] = src32[count];
+	}
+}
+
+/**
+ * copy_kernel - memcpy of the kernel
+ * @param dst		destination buffer
+ * @param src		source buffer
+ * @param len		bytes to copy
+ */
+static void copy_kernel(void *dst, void *src, u32 len)
+{
+	memcpy(dst, src, len);
+}
+
+/**
+ * get_copy_performance - measure a page copy routine
+ * @param name		name of the routine to print
+ * @param copy_fn	routine to measure
+ * @param dst		destination buffer of COPY_SIZE bytes
+ * @param src		source buffer of COPY_SIZE bytes
+ * @return		0 on success
+ * Both buffers are in RAM, so only the CPU side of a DataRAM transfer is
+ * measured. The bus cycles of the OneNAND are not included.
+ */
+static int get_copy_performance(const char *name, 
+		void (*copy_fn)(void *, void *, u32), char *dst, char *src)
+{
+	struct timeval start_time, stop_time;
+	u32 count, interval_usec;
+	u64 result;
+
+	do_gettimeofday(&start_time);
+	for (count = 0; count < copy; count++)
+	{
+		(*copy_fn)(dst, src, COPY_SIZE);
+	}
+	do_gettimeofday(&stop_time);
+
+	if (memcmp(dst, src, COPY_SIZE) != 0)
+	{
+		printk("copy: %s copied wrong data\n", name);
+		return -EIO;
+	}
+
+	interval_usec = (stop_time.tv_sec - start_time.tv_sec) * USEC_PER_SEC 
+		+ stop_time.tv_usec - start_time.tv_usec;
+
+	/* bytes per usec is MBytes per second */
+	result = (u64)copy * COPY_SIZE * FLOAT_POSITION;
+	do_div(result, interval_usec ? interval_usec : 1);
+
+	printk("copy: %-8s %d.%03dMB/s\n", name, 
+		(u32)result / FLOAT_POSITION, (u32)result % FLOAT_POSITION);
+
+	return 0;
+}
+
+/**
+ * get_copy_time - compare the page copy routines
+ * @return		0 on success
+ */
+static int get_copy_time(void)
+{
+	char *src, *dst;
+	u32 count;
+	int ret;
+
+	src = kmalloc(COPY_SIZE, GFP_KERNEL);
+	dst = kmalloc(COPY_SIZE, GFP_KERNEL);
+	if (!src || !dst)
+	{
+		kfree(src);
+		kfree(dst);
+		return -ENOMEM;
+	}
+
+	for (count = 0; count < COPY_SIZE; count++)
+	{
+		src[count] = (char)count;
+	}
+
+	printk("copy: %d copies of %d bytes\n", copy, COPY_SIZE);
+
+	ret = get_copy_performance("words", copy_words, dst, src);
+	if (ret == 0)
+	{
+		memset(dst, 0, COPY_SIZE);
+		ret = get_copy_performance("memcpy32", memcpy32, dst, src);
+	}
+	if (ret == 0)
+	{
+		memset(dst, 0, COPY_SIZE);
+		ret = get_copy_performance("memcpy", copy_kernel, dst, src);
+	}
+
+	kfree(src);
+	kfree(dst);
+
+	return ret;
+}
+
 /**
  * fsr benchmark module init
  * @return      0 on success
@@ -248,6 +511,12 @@ static int __init fsr_bench_init(void)
 	FSRStlInfo info;
 	struct performance_input dev_input;
 
+	/* measure the page copy routines only */
+	if (copy)
+	{
+		return get_copy_time();
+	}
+
 	/* check error of module parameter */
 	if (major == 0 || ((major != BLK_DEVICE_BML) && 
 				(major != BLK_DEVICE_STL))) 
@@ -275,6 +544,12 @@ static int __init fsr_bench_init(void)
 	dev_input.volume = fsr_vol(minor);
 	part_no = fsr_part(minor);
 
+	/* measure BML mount time only */
+	if (mount && major == BLK_DEVICE_BML)
+	{
+		return get_mount_time(dev_input.volume);
+	}
+
 	ps = fsr_get_part_spec(dev_input.volume);
 
 	dev_input.buf = kmalloc((sectors * SECTOR_SIZE), GFP_KERNEL);
@@ -396,6 +671,11 @@ static int __init fsr_bench_init(void)
 			printk("write: %d.%03dMB/s\n",
 				write_performance / FLOAT_POSITION,
 					write_performance % FLOAT_POSITION);
+
+			if (rand_writes) 
+			{
+				get_random_performance(dev_input);
+			}
 		}
 	
 		/* To remove Sam table effect after STL_Write */	
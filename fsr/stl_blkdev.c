@@ -39,6 +39,11 @@
 #define DEVICE_NAME		"stl"
 #define MAJOR_NR		BLK_DEVICE_STL
 
+/* discard requests are turned into STL delete */
+#if defined(CONFIG_RFS_STL_DELETE) && (LINUX_VERSION_CODE >= KERNEL_VERSION(2, 6, 28))
+#define STL_DISCARD
+#endif
+
 extern VOID memcpy32(VOID *pDst, VOID *pSrc, UINT32 nSize);
 
 static DECLARE_MUTEX(stl_list_mutex);
@@ -103,6 +108,44 @@ static int _fsr_dup_write(u32 volume, u32 part_id, unsigned long sector,
 
 #endif // end of #if defined(FSR_DUP_BUFFER)
 
+#ifdef STL_DISCARD
+/**
+ * prepare a discard request, nothing to set up for STL
+ * @param q		request queue
+ * @param req		discard request
+ * @return		0
+ */
+static int stl_prepare_discard(struct request_queue *q, struct request *req)
+{
+	return 0;
+}
+
+/**
+ * delete the sectors of a discard request from STL
+ * @param volume	volume(device) number
+ * @param part_id	partition id
+ * @param req		discard request
+ * @return		1 on success, 0 on failure
+ */
+static int stl_discard(u32 volume, u32 part_id, const struct request *req)
+{
+	int ret;
+
+	FSR_DOWN(&fsr_mutex);
+	ret = FSR_STL_Delete(volume, part_id, req->sector, req->nr_sectors,
+				FSR_STL_FLAG_USE_SM);
+	FSR_UP(&fsr_mutex);
+
+	if (ret != FSR_STL_SUCCESS)
+	{
+		ERRPRINTK("STL: discard error =%x\n", ret);
+		return 0;
+	}
+
+	return 1;
+}
+#endif
+
 /**
  * transfer data from STL to block device
  * @param volume 	volume(device) number 
@@ -136,6 +179,13 @@ static int stl_transfer(u32 volume, u32 partno, const struct request *req)
 	if (por_enable == 1)
 		return 0;
 #endif
+
+#ifdef STL_DISCARD
+	if (blk_discard_rq(req))
+	{
+		return stl_discard(volume, part_id, req);
+	}
+#endif
 	switch (rq_data_dir(req)) 
 	{
 		case READ:
@@ -213,6 +263,14 @@ static void stl_request(struct request_queue *rq)
 		if (fsr_is_whole_dev(partno))
 			goto end_req;
 
+#ifdef STL_DISCARD
+		/* discard carries no data, complete it at once */
+		if (blk_discard_rq(req))
+		{
+			req->current_nr_sectors = req->nr_sectors;
+		}
+		else
+#endif
 		if(req->current_nr_sectors != req->nr_sectors) 
 		{
 			blk_rq_map_sg(rq, req, dev->sg);
@@ -309,6 +367,9 @@ static int stl_add_disk(u32 volume, u32 partno)
 	dev->queue = blk_init_queue(stl_request, &dev->lock);
 	dev->queue->queuedata = dev;
 	dev->req = NULL;
+#ifdef STL_DISCARD
+	blk_queue_set_discard(dev->queue, stl_prepare_discard);
+#endif
 
 	/* alloc scatterlist */
 	dev->sg = kmalloc(sizeof(struct scatterlist) * dev->queue->max_phys_segments, GFP_KERNEL);
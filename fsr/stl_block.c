@@ -767,6 +767,71 @@ static int stl_delete(dev_t dev, u32 start, u32 nums, u32 b_size)
 	return 0;
 }
 
+/**
+ * Remove unnecessary STL map for a list of extents at once
+ * @param dev		major, minor
+ * @param ext		extents (start unit, numbers of unit) to delete
+ * @param nr_ext	number of extents
+ * @param b_size	unit size
+ * @return		0 on success, otherwise on failure
+ * @remark		STL sorts and merges the extents, and stores the
+ *			deleted info once for the whole list
+ */
+static int stl_delete_ext(dev_t dev, STL_DELETE_EXTENT_T *ext, u32 nr_ext, u32 b_size)
+{
+	u32 volume, partno, part_id, count, i;
+	u32 minor = MINOR(dev);
+	FSRStlDelExt *del_ext;
+	int ret;
+
+	volume = fsr_vol(minor);
+	partno = fsr_part(minor);
+
+	DEBUG(DL3,"STL[I]: volume(%d), partno(%d), nr_ext(%d)\n",volume, partno, nr_ext);
+
+	if (nr_ext == 0)
+	{
+		return 0;
+	}
+
+	/* called on the file system path, so don't recurse into it */
+	del_ext = kmalloc(sizeof(FSRStlDelExt) * nr_ext, GFP_NOFS);
+	if (!del_ext)
+	{
+		ERRPRINTK("kmalloc error\n");
+		return -ENOMEM;
+	}
+
+	count = b_size >> SECTOR_BITS;
+
+	for (i = 0; i < nr_ext; i++)
+	{
+		del_ext[i].nLsn = ext[i].start * count;
+		del_ext[i].nNumOfScts = ext[i].nums * count;
+	}
+
+	part_id = fsr_part_id(fsr_get_part_spec(volume), partno);
+
+	FSR_DOWN(&fsr_mutex);
+	ret = FSR_STL_DeleteExt(volume, part_id, del_ext, nr_ext, FSR_STL_FLAG_USE_SM);
+	FSR_UP(&fsr_mutex);
+
+	kfree(del_ext);
+
+	DEBUG(DL2,"@: %d extents - 0x%08x", nr_ext, ret);
+
+	/* I/O error */
+	if (ret != FSR_STL_SUCCESS)
+	{
+		ERRPRINTK("FSR_STL_DeleteExt error[0x%08x]\n", ret);
+		return -1;
+	}
+
+	DEBUG(DL3,"STL[O]: volume(%d), partno(%d)\n",volume, partno);
+
+	return 0;
+}
+
 #if defined(CONFIG_LINUSTOREIII_DEBUG) && defined(CONFIG_PROC_FS)
 
 /**
@@ -1131,6 +1196,7 @@ static int __init stl_block_init(void)
 	}
 
 	sec_stl_delete = stl_delete;
+	sec_stl_delete_ext = stl_delete_ext;
 
 	DEBUG(DL3,"STL[O]\n");
 
@@ -1153,6 +1219,7 @@ static void __exit stl_cleanup(void)
 #endif
 
 	sec_stl_delete = NULL;
+	sec_stl_delete_ext = NULL;
 	stl_blkdev_exit();
 
 	DEBUG(DL3,"STL[O]\n");
@@ -1169,6 +1236,7 @@ EXPORT_SYMBOL(FSR_STL_Close);
 EXPORT_SYMBOL(FSR_STL_Write);
 EXPORT_SYMBOL(FSR_STL_Read);
 EXPORT_SYMBOL(FSR_STL_Delete);
+EXPORT_SYMBOL(FSR_STL_DeleteExt);
 EXPORT_SYMBOL(FSR_STL_IOCtl);
 
 MODULE_LICENSE("Samsung Proprietary");
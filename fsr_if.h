@@ -136,6 +136,8 @@
 #define BML_GET_MAJOR_NUMBER			0x8A2E		///< get BML device minor number
 #define BML_GET_PART_ATTR			0x8A2F		///< get BML partition attribute
 #define BML_SET_PART_ATTR			0x8A30		///< set BML partition attribute
+#define BML_STREAM_BEGIN			0x8A36		///< start streaming image write to partition
+#define BML_STREAM_END				0x8A37		///< end streaming write, get CRC32 of data written
 
 /* OTP Operation commnad */
 #define BML_OTP_READ                            0x8A41          ///< OTP Read
@@ -238,6 +240,15 @@ typedef struct {
 	unsigned int nTotalSectors;				///< partition's total number of sector
 }STL_FORMAT_INFO_T;
 
+/**
+ * @brief	STL level delete extent
+ * @remark	used by file system to release a list of block ranges at once
+ */
+typedef struct {
+	unsigned int	start;					///< start block to delete
+	unsigned int	nums;					///< number of blocks to delete
+}STL_DELETE_EXTENT_T;
+
 /**
  * @brief	STL level information
  * @remark	total sectors, page size
@@ -29,6 +29,9 @@
 
 #include <linux/fs.h>
 #include <linux/rfs_fs.h>
+#ifdef CONFIG_RFS_MAPDESTROY
+#include <linux/fsr_if.h>
+#endif
 
 #include "rfs.h"
 #include "log.h"
@@ -520,6 +523,7 @@ del_list:
 
 #ifdef CONFIG_RFS_MAPDESTROY
 extern int (*sec_stl_delete)(dev_t dev, u32 start, u32 nums, u32 b_size);
+extern int (*sec_stl_delete_ext)(dev_t dev, STL_DELETE_EXTENT_T *ext, u32 nr_ext, u32 b_size);
 #endif
 /**
  *  deallocate clusters & call map_delete & free chunks
@@ -527,6 +531,8 @@ extern int (*sec_stl_delete)(dev_t dev, u32 start, u32 nums, u32 b_size);
  * @param nr_chunk	chunk count to delete
  * @return		return 0 on success, errno on failure
  *
+ * freed chunks are handed to STL in one extent list if possible,
+ * otherwise they are deleted one by one
  */
 static int __set_free_chunks(struct super_block *sb, unsigned int nr_chunk)
 {
@@ -537,11 +543,23 @@ static int __set_free_chunks(struct super_block *sb, unsigned int nr_chunk)
 	int ret = 0;
 	int idx;
 	int err;
+#ifdef CONFIG_RFS_MAPDESTROY
+	STL_DELETE_EXTENT_T *ext = NULL;
+	unsigned int nr_ext = 0;
+#endif
 
 
 	BUG_ON(!RFS_SB(sb)->nr_free_chunk);
 	BUG_ON(!nr_chunk);
 
+#ifdef CONFIG_RFS_MAPDESTROY
+	if (IS_DELETEABLE(sb->s_dev) && sec_stl_delete_ext)
+	{
+		/* if it fails, fall back to delete chunk by chunk */
+		ext = kmalloc(sizeof(STL_DELETE_EXTENT_T) * nr_chunk, GFP_NOFS);
+	}
+#endif
+
 	while (!list_empty(head) && nr_chunk)
 	{
 		p_clu_chunk = list_entry(head->next, struct clu_chunk_list, 
@@ -563,7 +581,13 @@ static int __set_free_chunks(struct super_block *sb, unsigned int nr_chunk)
 
 		}
 #ifdef CONFIG_RFS_MAPDESTROY
-		if (IS_DELETEABLE(sb->s_dev))
+		if (ext)
+		{
+			ext[nr_ext].start = START_BLOCK(start, sb);
+			ext[nr_ext].nums = count << RFS_SB(sb)->blks_per_clu_bits;
+			nr_ext++;
+		}
+		else if (IS_DELETEABLE(sb->s_dev))
 		{
 			sec_stl_delete(sb->s_dev, START_BLOCK(start,sb),
 					count << RFS_SB(sb)->blks_per_clu_bits,
@@ -578,6 +602,25 @@ static int __set_free_chunks(struct super_block *sb, unsigned int nr_chunk)
 	}
 	DEBUG(DL2, "nr_free_chunk%u", RFS_SB(sb)->nr_free_chunk);
 
+#ifdef CONFIG_RFS_MAPDESTROY
+	if (ext)
+	{
+		if (nr_ext && sec_stl_delete_ext(sb->s_dev, ext, nr_ext,
+					sb->s_blocksize))
+		{
+			DPRINTK("can't delete %u extents at once\n", nr_ext);
+
+			/* the sectors are still mapped, delete chunk by chunk */
+			for (idx = 0; idx < nr_ext; idx++)
+			{
+				sec_stl_delete(sb->s_dev, ext[idx].start,
+						ext[idx].nums, sb->s_blocksize);
+			}
+		}
+		kfree(ext);
+	}
+#endif
+
 	return ret;
 }
 
@@ -30,6 +30,7 @@
 #include <linux/fs.h>
 #include <linux/rfs_fs.h>
 #include "rfs.h"
+#include "log.h"
 
 /*
  * structure for FAT cache (INCORE)
@@ -39,6 +40,16 @@ struct rfs_fcache {
 	unsigned int f_dirty;
 	struct buffer_head *f_bh;
 	struct list_head list;
+	struct list_head d_list;	/* link in dirty list */
+};
+
+/*
+ * dirty set of FAT cache (INCORE)
+ * it is allocated right after the fcache entries
+ */
+struct rfs_fcache_dirty {
+	struct list_head head;		/* dirty entries sorted by blkoff */
+	unsigned int count;
 };
 
 /*
@@ -47,9 +58,21 @@ struct rfs_fcache {
 #define FAT_CACHE_SIZE_DEF	128
 #define FAT_CACHE_SIZE_MIN	16
 
+/* the number of buffers submitted at once by writeback */
+#define FAT_CACHE_WB_BATCH	16
+
 #define FAT_CACHE_HEAD(sb)	(&(RFS_SB(sb)->fcache_lru_list))
 #define FAT_CACHE_ENTRY(p)	list_entry(p, struct rfs_fcache, list)
 
+#define FAT_CACHE_DIRTY(sb)						\
+	((struct rfs_fcache_dirty *)					\
+	 ((struct rfs_fcache *) RFS_SB(sb)->fcache_array + 		\
+	  RFS_SB(sb)->fcache_size))
+#define FAT_CACHE_DIRTY_ENTRY(p)	list_entry(p, struct rfs_fcache, d_list)
+
+/* start writeback when 3/4 of fcache is dirty */
+#define FAT_CACHE_DIRTY_HIGH(sb)	((RFS_SB(sb)->fcache_size * 3) >> 2)
+
 /************************************************************************/
 /* FAT table manipulations						*/
 /************************************************************************/
@@ -122,6 +145,7 @@ static inline unsigned int __parse_fcache_size(struct super_block *sb)
 int rfs_fcache_init(struct super_block *sb)
 {
 	struct rfs_fcache *array = NULL;
+	struct rfs_fcache_dirty *dirty;
 	int i, len;
 
 	/* parsing fcache size */
@@ -133,7 +157,8 @@ int rfs_fcache_init(struct super_block *sb)
 		RFS_SB(sb)->fcache_size = __parse_fcache_size(sb);
 	}
 
-	len = sizeof(struct rfs_fcache) * RFS_SB(sb)->fcache_size;
+	len = sizeof(struct rfs_fcache) * RFS_SB(sb)->fcache_size +
+		sizeof(struct rfs_fcache_dirty);
 
 	array = (struct rfs_fcache *) rfs_kmalloc(len, GFP_KERNEL, NORETRY);
 	if (!array) /* memory error */
@@ -150,10 +175,15 @@ int rfs_fcache_init(struct super_block *sb)
 		array[i].f_dirty = FALSE;
 		array[i].f_bh = NULL;
 		list_add_tail(&(array[i].list), FAT_CACHE_HEAD(sb));
+		INIT_LIST_HEAD(&(array[i].d_list));
 	}
 
 	RFS_SB(sb)->fcache_array = array;
 
+	dirty = FAT_CACHE_DIRTY(sb);
+	INIT_LIST_HEAD(&(dirty->head));
+	dirty->count = 0;
+
 	return 0;
 }
 
@@ -179,6 +209,84 @@ void rfs_fcache_release(struct super_block *sb)
 	}
 }
 
+/**
+ *  insert fat cache entry into dirty list in order of block number
+ * @param sb		super block
+ * @param fcache_p	fat cache entry to be dirty
+ */
+static void __fcache_add_dirty(struct super_block *sb,
+		struct rfs_fcache *fcache_p)
+{
+	struct rfs_fcache_dirty *dirty = FAT_CACHE_DIRTY(sb);
+	struct list_head *p;
+
+	fcache_p->f_dirty = TRUE;
+
+	/* FAT is usually updated in ascending order, search from tail */
+	list_for_each_prev(p, &dirty->head) {
+		if (FAT_CACHE_DIRTY_ENTRY(p)->blkoff < fcache_p->blkoff)
+			break;
+	}
+	list_add(&fcache_p->d_list, p);
+	dirty->count++;
+}
+
+/**
+ *  remove fat cache entry from dirty list and mark its buffer dirty
+ * @param sb		super block
+ * @param fcache_p	dirty fat cache entry
+ */
+static void __fcache_del_dirty(struct super_block *sb,
+		struct rfs_fcache *fcache_p)
+{
+	rfs_mark_buffer_dirty(fcache_p->f_bh, sb);
+	fcache_p->f_dirty = FALSE;
+
+	list_del_init(&fcache_p->d_list);
+	FAT_CACHE_DIRTY(sb)->count--;
+}
+
+/**
+ *  write back all dirty fat cache entries
+ * @param sb	super block
+ * @param wait	whether to wait for I/O completion or not
+ *
+ * dirty entries are submitted in order of block number,
+ * so contiguous FAT blocks are merged into one request by block layer.
+ */
+static void __fcache_writeback(struct super_block *sb, int wait)
+{
+	struct rfs_fcache_dirty *dirty = FAT_CACHE_DIRTY(sb);
+	struct buffer_head *bhs[FAT_CACHE_WB_BATCH];
+	struct rfs_fcache *fcache_p;
+	int count, i;
+
+	/* log records should reach the disk before FAT */
+	tr_wait_records(sb);
+
+	while (!list_empty(&dirty->head)) {
+		for (count = 0; count < FAT_CACHE_WB_BATCH &&
+				!list_empty(&dirty->head); count++) {
+			fcache_p = FAT_CACHE_DIRTY_ENTRY(dirty->head.next);
+			__fcache_del_dirty(sb, fcache_p);
+			rfs_set_bh_bit(BH_RFS_FAT, &(fcache_p->f_bh->b_state));
+			bhs[count] = fcache_p->f_bh;
+		}
+
+		ll_rw_block(WRITE, count, bhs);
+
+		if (likely(!wait))
+			continue;
+
+		/* check write I/O result */
+		for (i = 0; i < count; i++) {
+			wait_on_buffer(bhs[i]);
+			if (!buffer_uptodate(bhs[i]))
+				RFS_BUG_CRASH(sb, "Fail to write\n");
+		}
+	}
+}
+
 /**
  *  sync all fat cache entries if dirty flag of them are set
  * @param sb	super block
@@ -188,34 +296,16 @@ void rfs_fcache_release(struct super_block *sb)
  */ 
 void rfs_fcache_sync(struct super_block *sb, int flush)
 {
-	struct rfs_fcache *fcache_p;
-	struct list_head *head, *p;
+	struct rfs_fcache_dirty *dirty = FAT_CACHE_DIRTY(sb);
 
-	head = FAT_CACHE_HEAD(sb);
-
-	list_for_each(p, head) 
+	if (unlikely(flush)) 
 	{
-		fcache_p = FAT_CACHE_ENTRY(p);
-		if (fcache_p->f_dirty) 
-		{
-			rfs_mark_buffer_dirty(fcache_p->f_bh, sb);
-			fcache_p->f_dirty = FALSE;
-
-			if (unlikely(flush)) 
-			{
-				ll_rw_block(WRITE, 1, &fcache_p->f_bh);
-
-				/* check write I/O result */
-				wait_on_buffer(fcache_p->f_bh);
-				if (!buffer_uptodate(fcache_p->f_bh))
-				{
-					RFS_BUG_CRASH(sb, "Fail to write\n");
-				}
-				rfs_set_bh_bit(BH_RFS_FAT, 
-						&(fcache_p->f_bh->b_state));
-			}
-		}
+		__fcache_writeback(sb, 1);
+		return;
 	}
+
+	while (!list_empty(&dirty->head))
+		__fcache_del_dirty(sb, FAT_CACHE_DIRTY_ENTRY(dirty->head.next));
 }
 
 /**
@@ -233,10 +323,18 @@ static void __fcache_set_modify(struct super_block *sb, sector_t blkoff)
 	list_for_each(p, FAT_CACHE_HEAD(sb)) {
 		fcache_p = FAT_CACHE_ENTRY(p);
 		if (fcache_p->blkoff == blkoff) {
-			fcache_p->f_dirty = TRUE;
-			return;
+			if (!fcache_p->f_dirty)
+				__fcache_add_dirty(sb, fcache_p);
+			break;
 		}
 	}
+
+	/* 
+	 * start writeback before fcache runs out of clean entries,
+	 * I/O is completed in background
+	 */
+	if (FAT_CACHE_DIRTY(sb)->count >= FAT_CACHE_DIRTY_HIGH(sb))
+		__fcache_writeback(sb, 0);
 }
 
 /**
@@ -263,11 +361,20 @@ retry:
 	}
 
 	if (unlikely(p == head)) {
-		/* there is no clean fat cache. So, perform fat cache flush */
-		rfs_fcache_sync(sb, 1);
+		/* there is no clean fat cache. So, start fat cache writeback */
+		__fcache_writeback(sb, 0);
 		goto retry;
 	}
 
+	if (fcache_p->f_bh) {
+		/* the victim may be still under writeback */
+		wait_on_buffer(fcache_p->f_bh);
+		if (!buffer_uptodate(fcache_p->f_bh))
+		{
+			RFS_BUG_CRASH(sb, "Fail to write\n");
+		}
+	}
+
 	brelse(fcache_p->f_bh);
 
 	/*
@@ -494,57 +601,17 @@ int rfs_fat_write(struct super_block *sb, unsigned int location, unsigned int co
 /************************************************************************/
 
 /**
- *  burst read blocks and insert them to fat cache
+ *  submit burst read of fat blocks without waiting for completion
  * @param sb super block
+ * @param bhs[out] buffer heads of fat blocks
  * @param blocknr the start block number of burst read
  * @param count the number of block to be read
- * @return return the number of blocks read on success, errno on failure
+ * @return return 0 on success, errno on failure
  */
-static int __fcache_burst_read(struct super_block *sb, sector_t blocknr, 
-		int count)
+static int __fat_burst_read_submit(struct super_block *sb,
+		struct buffer_head **bhs, sector_t blocknr, int count)
 {
-	struct buffer_head **bhs = NULL;
-	struct list_head *head, *p;
-	struct rfs_fcache *fcache_p;
-	unsigned int i;
-
-	if (!count)
-		return 0;
-
-	if (count < 0) {
-		DPRINTK("Err in reading burst fat table\n");
-		return -EIO;
-	}
-
-	if (count > RFS_SB(sb)->fcache_size)
-		count = RFS_SB(sb)->fcache_size;
-
-
-	bhs = rfs_kmalloc(sizeof(struct buffer_head *) * count, GFP_KERNEL,
-				NORETRY);
-
-	if (bhs == NULL)
-		return -ENOMEM;
-
-	/* release fat cache for memory usage */
-	head = FAT_CACHE_HEAD(sb);
-	for (i = 0, p = head->next; i < count; i++, p = p->next) {
-		fcache_p = FAT_CACHE_ENTRY(p);
-		if (fcache_p->f_bh) {
-			if (fcache_p->f_dirty) {
-				mark_buffer_dirty(fcache_p->f_bh);
-				fcache_p->f_dirty = FALSE;
-			}
-
-			DEBUG(DL3, "relesing buffer (%lu : %p)\n",
-				       (unsigned long) fcache_p->blkoff, 
-				       fcache_p->f_bh);
-
-			brelse(fcache_p->f_bh);
-			fcache_p->f_bh = NULL;
-			fcache_p->blkoff = NOT_ASSIGNED;
-		}
-	}
+	int i;
 
 	for (i = 0; i < count; i++) {
 		bhs[i] = sb_getblk(sb, blocknr + i);
@@ -552,40 +619,69 @@ static int __fcache_burst_read(struct super_block *sb, sector_t blocknr,
 				(unsigned long) (blocknr + i), bhs[i]);
 		if (!bhs[i]) {
 			DPRINTK("Err in getting bh\n");
-			kfree(bhs);
+			while (i--)
+				brelse(bhs[i]);
 			return -EIO;
 		}
 	}
 
-	/* burst read  */
+	/* burst read, I/O is completed while counting previous burst */
 	ll_rw_block(READ, count, bhs);
 
-	head = FAT_CACHE_HEAD(sb);
-	p = head->next; 
+	return 0;
+}
 
-	/* add buffer in fat cache */
-	for (i = 0; i < count; i++) 
-	{
-		/* check I/O completion */
-		wait_on_buffer(bhs[i]);
-		if (!buffer_uptodate(bhs[i])) 
-		{
-			RFS_BUG_CRASH(sb, "Fail to read\n");
-			kfree(bhs);
-			return -EIO;
+/**
+ *  count free entries of a fat block
+ * @param sb super block
+ * @param data contents of fat block
+ * @param start the first entry index in the block to count
+ * @param end the last entry index in the block to count (exclusive)
+ * @return the number of free entries
+ *
+ * FAT entries are tested a 32bit word at a time without decoding them
+ */
+static unsigned int __fat_count_free(struct super_block *sb, void *data,
+		unsigned int start, unsigned int end)
+{
+	u32 *word = (u32 *) data;
+	u32 value;
+	unsigned int count = 0;
+
+	if (IS_FAT32(RFS_SB(sb))) {
+		/* upper 4 bits of FAT32 entry are reserved */
+		for (; start < end; start++) {
+			if (!(word[start] & cpu_to_le32(0x0FFFFFFF)))
+				count++;
 		}
-		rfs_set_bh_bit(BH_RFS_FAT, &bhs[i]->b_state);
+		return count;
+	}
 
-		fcache_p = FAT_CACHE_ENTRY(p);
+	/* FAT16 : 2 entries in a word */
+	if (start & 1) {
+		if (!((u16 *) data)[start])
+			count++;
+		start++;
+	}
 
-		fcache_p->f_bh = bhs[i];
-		fcache_p->blkoff = blocknr + i;
-		fcache_p->f_dirty = FALSE;
+	for (; start + 1 < end; start += 2) {
+		value = word[start >> 1];
+		if (!value) {
+			count += 2;
+		} else {
+			/* zero test of halves doesn't depend on endian */
+			if (!(value & 0x0000FFFF))
+				count++;
+			if (!(value & 0xFFFF0000))
+				count++;
+		}
+	}
 
-		p = p->next;
+	if (start < end) {
+		if (!((u16 *) data)[start])
+			count++;
 	}
 
-	kfree(bhs);
 	return count;
 }
 
@@ -595,18 +691,22 @@ static int __fcache_burst_read(struct super_block *sb, sector_t blocknr,
  * @param[out] used_clusters the number of used clusters in volume 
  * @return return 0 on success, errno on failure
  *
- * cluster 0 & 1 are reserved according to the fat spec
+ * cluster 0 & 1 are reserved according to the fat spec.
+ * FAT is read in bursts of fcache_size blocks, and the next burst is
+ * submitted before counting the current one to overlap I/O and counting.
  */
 int rfs_count_used_clusters(struct super_block *sb, unsigned int *used_clusters)
 {
-	sector_t start_blocknr;
-	unsigned int i, clu;
-	unsigned int count = 2; /* clu 0 & 1 are reserved */
+	struct buffer_head **bhs = NULL;
+	struct buffer_head **cur, **next, **tmp;
+	sector_t blocknr;
 	unsigned int fat_bits;
-	unsigned int max_index;
-	int read_cache;
+	unsigned int epb_bits;		/* entries per block in bits */
+	unsigned int clu, start, end;
+	unsigned int free_count = 0;
+	int burst, cur_count, next_count;
 	int fat_blocks;
-	int err;
+	int i, err = 0;
 
 	/* make fat bits for multiply */
 	if (IS_FAT16(RFS_SB(sb))) {
@@ -617,62 +717,95 @@ int rfs_count_used_clusters(struct super_block *sb, unsigned int *used_clusters)
 		RFS_BUG("Unknown FAT type\n");
 		return -EIO;
 	}
+	epb_bits = sb->s_blocksize_bits - fat_bits;
 
 	/* get start blocknr and size of 1st fat table */
-	start_blocknr = 
+	blocknr = 
 		(sector_t) (RFS_SB(sb)->fat_start_addr >> sb->s_blocksize_bits);
 	fat_blocks = ((RFS_SB(sb)->num_clusters << fat_bits)
 			+ sb->s_blocksize - 1) >> sb->s_blocksize_bits;
 
 	DEBUG(DL3, "start blocknr : %lu, numof fat blocks : %u\n",
-			(unsigned long) start_blocknr, fat_blocks);
+			(unsigned long) blocknr, fat_blocks);
+
+	burst = RFS_SB(sb)->fcache_size;
+	bhs = rfs_kmalloc(sizeof(struct buffer_head *) * (burst << 1),
+			GFP_KERNEL, NORETRY);
+	if (bhs == NULL)
+		return -ENOMEM;
+	cur = bhs;
+	next = bhs + burst;
+
 	fat_lock(sb);
 
-	/* set the maximum read cluster index */
-	max_index = 0;
-
-	for (i = VALID_CLU; i < RFS_SB(sb)->num_clusters; i++) {
-		if (i >= max_index) {
-			/* read burst the next part of fat table */
-			read_cache = __fcache_burst_read(sb, start_blocknr,
-					(fat_blocks > RFS_SB(sb)->fcache_size) ?
-					RFS_SB(sb)->fcache_size :
-					fat_blocks);
-
-			if (read_cache < 0) {
-				DPRINTK("Err(%d) in counting free clusters\n",
-						read_cache);
-				fat_unlock(sb);
-				return read_cache;
+	/* submit the first burst */
+	cur_count = (fat_blocks > burst) ? burst : fat_blocks;
+	err = __fat_burst_read_submit(sb, cur, blocknr, cur_count);
+	if (err)
+		goto out;
+	blocknr += cur_count;
+	fat_blocks -= cur_count;
+
+	/* the first cluster number of current burst */
+	clu = 0;
+
+	while (cur_count) {
+		/* submit the next burst before counting current one */
+		next_count = (fat_blocks > burst) ? burst : fat_blocks;
+		if (next_count) {
+			err = __fat_burst_read_submit(sb, next, blocknr,
+					next_count);
+			if (err)
+				next_count = 0;
+			blocknr += next_count;
+			fat_blocks -= next_count;
+		}
+
+		for (i = 0; i < cur_count; i++) {
+			/* check I/O completion */
+			wait_on_buffer(cur[i]);
+			if (!err && !buffer_uptodate(cur[i])) {
+				RFS_BUG_CRASH(sb, "Fail to read\n");
+				err = -EIO;
 			}
 
-			/* update vars for next burst read */
-			fat_blocks -= read_cache;
-			max_index += (sb->s_blocksize * read_cache) >> fat_bits;
+			if (!err) {
+				start = (clu < VALID_CLU) ? VALID_CLU - clu : 0;
+				end = 1 << epb_bits;
+				if (clu + end > RFS_SB(sb)->num_clusters)
+					end = RFS_SB(sb)->num_clusters - clu;
 
-			DEBUG(DL3, "read burst %uth from %lu (%u entries)\n",
-					read_cache, 
-					(unsigned long) start_blocknr, 
-					max_index);
+				free_count += __fat_count_free(sb,
+						cur[i]->b_data, start, end);
+			}
 
-			start_blocknr += read_cache;
+			brelse(cur[i]);
+			clu += 1 << epb_bits;
 		}
 
-		/* expect the hit on fat cache due to burst read */
-		err = rfs_fat_read(sb, i, &clu);
 		if (err) {
-			fat_unlock(sb);
-			DPRINTK("can't read a fat entry (%u)\n", i);
-			return err;
+			/* release submitted next burst */
+			for (i = 0; i < next_count; i++) {
+				wait_on_buffer(next[i]);
+				brelse(next[i]);
+			}
+			goto out;
 		}
 
-		if (clu)
-			count++;
+		tmp = cur;
+		cur = next;
+		next = tmp;
+		cur_count = next_count;
 	}
 
-	*used_clusters = count;
+	*used_clusters = RFS_SB(sb)->num_clusters - free_count;
 
+out:
 	fat_unlock(sb);
+	kfree(bhs);
 
-	return 0;
+	if (err)
+		DPRINTK("Err(%d) in counting free clusters\n", err);
+
+	return err;
 }
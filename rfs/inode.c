@@ -1053,6 +1053,11 @@ int rfs_sync_inode(struct inode *inode, int data_commit, int wait)
 	if (RFS_I(inode)->i_state == RFS_I_FREE)
 		return 0;
 
+	/* log records should reach the disk before dir entry */
+	ret = tr_wait_records(sb);
+	if (ret)
+		return ret;
+
 	if (inode->i_ino == ROOT_INO)
 #ifndef CONFIG_RFS_FS_XATTR
 		return 0;
@@ -76,6 +76,7 @@ static int __log_mark_end(struct super_block *sb, unsigned int sub_type);
 static int __log_read(struct super_block *sb, unsigned int isec);
 static int __log_write(struct super_block *sb);
 static int __log_mwrite(struct super_block *sb, int count, struct buffer_head **bhs);
+static int __log_submit(struct super_block *sb, int count, struct buffer_head **bhs);
 static int __log_read_ahead(struct super_block *sb, unsigned int isec, 
 		int count, struct buffer_head **bhs);
 static int __log_dealloc_chain(struct super_block *sb, struct log_DEALLOC_info *,
@@ -106,7 +107,15 @@ void mark_buffer_tr_dirty(struct buffer_head *bh, struct super_block *sb)
 
 #ifdef RFS_FOR_2_4
 	struct inode *tr_inode = &(RFS_LOG_I(sb)->tr_buf_inode);
+#endif
+
+	/*
+	 * dirty metadata can be written back at any time,
+	 * so log records of the transaction should reach the disk first
+	 */
+	tr_wait_records(sb);
 
+#ifdef RFS_FOR_2_4
 	mark_buffer_dirty(bh);
 
 	if (RFS_LOG_I(sb) && (get_log_lock_owner(sb) == current->pid)) {
@@ -148,6 +157,11 @@ int rfs_meta_commit(struct super_block *sb)
 	int err = 0, ret = 0;
 	int data_commit = 0;
 
+	/* log records should reach the disk before metadata */
+	err = rfs_log_wait_records(sb);
+	if (err)
+		return err;
+
 	/*
 	 * sync fcache
 	 * (just make buffers dirty in fcache)
@@ -494,6 +508,7 @@ void rfs_log_release(struct super_block *sb)
 	 */
 	__commit_deferred_tr(sb, 0);
 	/* release buffer head for current log block */
+	rfs_log_wait_records(sb);
 	brelse(RFS_LOG_I(sb)->bh);
 
 	/* free memory for loginfo */
@@ -608,6 +623,7 @@ static int __log_open(struct super_block *sb)
 	rli->bh = NULL;
 	rli->inode = NULL;
 	rli->isec = 0;
+	rli->nr_pending = 0;
 
 	/* init fields for deferred commit */
 	rli->alloc_index = 0;
@@ -791,6 +807,10 @@ static int __commit_deferred_tr(struct super_block *sb, unsigned long ino)
 	}
 
 out:
+	/* log records never stay pending out of the log lock */
+	if (rfs_log_wait_records(sb) && !ret)
+		ret = -EIO;
+
 	return ret;
 }
 
@@ -809,6 +829,11 @@ int rfs_log_commit_mrc(struct super_block *sb, struct log_DEALLOC_info *ldi)
 	struct rfs_log_info *rli = RFS_LOG_I(sb);
 	int ret = 0;
 
+	/* log records should reach the disk before metadata */
+	ret = rfs_log_wait_records(sb);
+	if (ret)
+		goto out;
+
 	/*
 	 * sync fcache
 	 * (just make buffers dirty in fcache)
@@ -853,7 +878,7 @@ int rfs_log_commit_mrc(struct super_block *sb, struct log_DEALLOC_info *ldi)
 	SET32(rli->log->log_dealloc.nr_chunk, 0);
 	SET32(rli->log->log_dealloc.next_chunks, ldi->next_clu);
 
-	if (rli->operations->log_write(sb))
+	if (rli->operations->log_write(sb) || rfs_log_wait_records(sb))
 	{
 		DEBUG(DL0, "log_write fails");
 		ret = -EIO;
@@ -1023,6 +1048,10 @@ int rfs_log_end(struct super_block *sb, int result)
 rel_lock:
 	CHECK_MUTEX(get_log_lock_depth(sb), 1);
 
+	/* log records never stay pending out of the log lock */
+	if (rfs_log_wait_records(sb) && !ret)
+		ret = -EIO;
+
 	unlock_log(sb);
 
 #ifdef RFS_CLUSTER_CHANGE_NOTIFY
@@ -1940,6 +1969,13 @@ static int __log_mark_end(struct super_block *sb, unsigned int sub_type)
 		DEBUG(DL0, "log_write fail");
 		return -EIO;
 	}
+
+	/* commit mark is the only point to wait for log records */
+	if (rfs_log_wait_records(sb))
+	{
+		DEBUG(DL0, "log_write fail");
+		return -EIO;
+	}
 		
 	RFS_LOG_I(sb)->inode = NULL;
 	RFS_LOG_I(sb)->type = RFS_LOG_NONE;
@@ -2071,6 +2107,71 @@ out:
 	return ret;
 }
 	
+/**
+ * wait for completion of log blocks submitted and release them
+ * @param sb super block
+ * @return 0 on success, errno on failure
+ */
+int rfs_log_wait_records(struct super_block *sb)
+{
+	struct rfs_log_info *rli = RFS_LOG_I(sb);
+	int i, ret = 0;
+
+	/* pending list is shared by the log lock holder */
+	lock_log(sb);
+
+	for (i = 0; i < rli->nr_pending; i++)
+	{
+		/* check I/O completion */
+		wait_on_buffer(rli->pending[i]);
+		if (!ret && !buffer_uptodate(rli->pending[i]))
+		{
+			RFS_BUG_CRASH(sb, "RFS-log : Fail to write a log "
+					"record\n");
+			ret = -EIO;
+		}
+		/* reduce ref count */
+		brelse(rli->pending[i]);
+	}
+	rli->nr_pending = 0;
+
+	unlock_log(sb);
+
+	return ret;
+}
+
+/**
+ * submit log blocks without waiting for completion
+ * @param sb super block
+ * @param nr_record count of bhs array [record unit]
+ * @param bhs pointer of buffer_head array, their ref counts are handed over
+ * @return 0 on success, errno on failure
+ *
+ * log blocks remain pending until rfs_log_wait_records() is called
+ * at commit or before metadata is written
+ */
+static int __log_submit(struct super_block *sb, int nr_record, 
+		struct buffer_head **bhs)
+{
+	struct rfs_log_info *rli = RFS_LOG_I(sb);
+	int i_rec, ret = 0;
+
+	if (rli->nr_pending + nr_record > RFS_LOG_MAX_PENDING)
+		ret = rfs_log_wait_records(sb);
+
+	/* locked buffer is skipped by ll_rw_block(), wait previous write */
+	for (i_rec = 0; i_rec < nr_record; i_rec++)
+		wait_on_buffer(bhs[i_rec]);
+
+	/* bust write */
+	ll_rw_block(WRITE, nr_record, bhs);
+
+	for (i_rec = 0; i_rec < nr_record; i_rec++)
+		rli->pending[rli->nr_pending++] = bhs[i_rec];
+
+	return ret;
+}
+
 /**
  * write log to logfile and release it
  * @param log_info rfs's log structure	
@@ -2090,13 +2191,10 @@ static int __log_write(struct super_block *sb)
 	SET64(rli->log->sequence, rli->sequence);
 	SET32(rli->log->signature, RFS_MAGIC);
 	mark_buffer_dirty(rli->bh);
-	ret = rfs_sync_dirty_buffer(rli->bh);
-	if (ret) 
-	{
-		RFS_BUG_CRASH(sb, "RFS-log : Fail to write a log record\n");
-	}
 
-	brelse(rli->bh);
+	/* log block is released after completion */
+	ret = __log_submit(sb, 1, &(rli->bh));
+
 	rli->bh = NULL;
 	rli->log = NULL;
 	rli->dirty = TRUE;
@@ -2115,27 +2213,14 @@ static int __log_write(struct super_block *sb)
 static int __log_mwrite(struct super_block *sb, int nr_record, 
 		struct buffer_head **bhs)
 {
-	int i_rec;
+	int ret;
 
 	DEBUG(DL3, "cnt:%d\n", nr_record);
-	/* bust write */
-	ll_rw_block(WRITE, nr_record, bhs);
-	for (i_rec = 0; i_rec < nr_record; i_rec++)
-	{
-		/* check I/O completion */
-		wait_on_buffer(bhs[i_rec]);
-		if (!buffer_uptodate(bhs[i_rec]))
-		{
-			RFS_BUG_CRASH(sb, "RFS-log: cann't write log "
-					"record(%u)\n", i_rec);
-			return -EIO;
-		}
-		/* reduce ref count */
-		brelse(bhs[i_rec]);
-	}
+	/* records are released after completion */
+	ret = __log_submit(sb, nr_record, bhs);
 	RFS_LOG_I(sb)->dirty = TRUE;
 
-	return 0;
+	return ret;
 }
 
 /*****************************************************************************/
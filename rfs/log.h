@@ -72,6 +72,7 @@
 #define RFS_LOG_MAX_COUNT		256 
 #define RFS_LOG_MAX_SIZE_IN_BYTE	RFS_LOG_MAX_COUNT << SECTOR_BITS 
 #define RFS_LOG_MAX_MULTI_BLOCK_RECORD	((RFS_LOG_MAX_COUNT >> 1) - 1)
+#define RFS_LOG_MAX_PENDING		(RFS_LOG_MAX_MULTI_BLOCK_RECORD + 1)
 
 /* transaction type */
 #define RFS_LOG_NONE			(unsigned int) 0x0000
@@ -338,6 +339,10 @@ struct rfs_log_info {
 	struct buffer_head *bh;
 	struct rfs_trans_log *log;
 
+	/* log blocks submitted but not waited for */
+	int nr_pending;
+	struct buffer_head *pending[RFS_LOG_MAX_PENDING];
+
 	unsigned int l_start_cluster;	/* for logfile itself */
 	unsigned int l_last_cluster;	/* last clu # of logile itself */
 
@@ -401,6 +406,22 @@ int tr_deferred_commit(struct super_block *sb);
 /* called by cluster */
 int rfs_meta_commit(struct super_block *sb);
 
+/* called by fcache, inode and super */
+int rfs_log_wait_records(struct super_block *sb);
+
+/*
+ * wait for log records only inside transaction.
+ * pending log records never stay out of the log lock,
+ * and taking the log lock under fat lock inverts the lock order
+ */
+static inline int tr_wait_records(struct super_block *sb)
+{
+	if (RFS_LOG_I(sb) && (get_log_lock_owner(sb) == current->pid))
+		return rfs_log_wait_records(sb);
+
+	return 0;
+}
+
 int rfs_log_get_cluster(struct inode *inode, unsigned int *new_clu);
 
 int rfs_log_segment_add(struct super_block *sb,unsigned int, unsigned int);
@@ -28,6 +28,9 @@
  */
 
 #include <linux/rfs_fs.h>
+#ifdef CONFIG_RFS_MAPDESTROY
+#include <linux/fsr_if.h>
+#endif
 #include "rfs.h"
 #include "log.h"
 
@@ -35,6 +38,9 @@
 #include "xattr.h"
 #endif
 
+/* the number of log blocks read at once by prefetch */
+#define RFS_LOG_PREFETCH_BLOCKS	16
+
 
 /**
  * undo alloc chain from fat table
@@ -680,6 +686,7 @@ static int __log_redo_dealloc_source_and_log(struct super_block *sb,
 
 #ifdef CONFIG_RFS_MAPDESTROY
 extern int (*sec_stl_delete)(dev_t dev, u32 start, u32 nums, u32 b_size);
+extern int (*sec_stl_delete_ext)(dev_t dev, STL_DELETE_EXTENT_T *ext, u32 nr_ext, u32 b_size);
 #endif
 /**
  * redo dealloc chunks and make logfile and source complete
@@ -706,6 +713,10 @@ static int __redo_dealloc_chain(struct super_block *sb, unsigned int cur_isec,
 	unsigned int ilog, iclu, isec, ichunk;
 	unsigned int sec_off;
 	int err = 0;
+#ifdef CONFIG_RFS_MAPDESTROY
+	STL_DELETE_EXTENT_T *ext = NULL;
+	unsigned int nr_ext = 0;
+#endif
 
 	secs_per_blk = RFS_LOG_I(sb)->secs_per_blk;
 
@@ -724,6 +735,15 @@ static int __redo_dealloc_chain(struct super_block *sb, unsigned int cur_isec,
 		return -EIO;
 	}
 
+#ifdef CONFIG_RFS_MAPDESTROY
+	if (IS_DELETEABLE(sb->s_dev) && sec_stl_delete_ext)
+	{
+		/* a log holds at most RFS_LOG_MAX_CHUNKS chunks */
+		ext = kmalloc(sizeof(STL_DELETE_EXTENT_T) * nr_logs *
+				RFS_LOG_MAX_CHUNKS, GFP_NOFS);
+	}
+#endif
+
 	/* release chunks */
 	for (ilog = 0; ilog < nr_logs; ilog++)
 	{
@@ -750,11 +770,18 @@ static int __redo_dealloc_chain(struct super_block *sb, unsigned int cur_isec,
 				if (unlikely(err))
 				{
 					DPRINTK("Can't write fat\n");
-					return err;
+					goto out;
 				}
 			}
 #ifdef CONFIG_RFS_MAPDESTROY
-			if (IS_DELETEABLE(sb->s_dev))
+			if (ext)
+			{
+				ext[nr_ext].start = START_BLOCK(start, sb);
+				ext[nr_ext].nums = nr_clus <<
+					RFS_SB(sb)->blks_per_clu_bits;
+				nr_ext++;
+			}
+			else if (IS_DELETEABLE(sb->s_dev))
 			{
 				sec_stl_delete(sb->s_dev, START_BLOCK(start, sb),
 					nr_clus <<RFS_SB(sb)->blks_per_clu_bits,
@@ -764,6 +791,29 @@ static int __redo_dealloc_chain(struct super_block *sb, unsigned int cur_isec,
 		}
 	}
 
+#ifdef CONFIG_RFS_MAPDESTROY
+	if (ext && nr_ext &&
+			sec_stl_delete_ext(sb->s_dev, ext, nr_ext, sb->s_blocksize))
+	{
+		DPRINTK("Can't delete %u extents at once\n", nr_ext);
+
+		/* the sectors are still mapped, delete chunk by chunk */
+		for (ichunk = 0; ichunk < nr_ext; ichunk++)
+		{
+			sec_stl_delete(sb->s_dev, ext[ichunk].start,
+					ext[ichunk].nums, sb->s_blocksize);
+		}
+	}
+#endif
+out:
+#ifdef CONFIG_RFS_MAPDESTROY
+	kfree(ext);
+#endif
+	if (unlikely(err))
+	{
+		return err;
+	}
+
 	/*
 	 * following actions will be taken by rfs_log_replay()
 	 * sync meta;
@@ -1002,6 +1052,35 @@ static int __sequential_search_max(struct super_block *sb, unsigned int from,
 	return 0;
 }
 
+/**
+ * read whole logfile ahead with burst reads
+ * @param sb super block
+ *
+ * log records are searched one by one later, they hit the buffer cache
+ */
+static void __log_prefetch(struct super_block *sb)
+{
+	struct rfs_log_info* rli = RFS_LOG_I(sb);
+	struct buffer_head *bhs[RFS_LOG_PREFETCH_BLOCKS];
+	unsigned int isec;
+	int i, count = 0;
+
+	for (isec = 0; isec < RFS_LOG_MAX_COUNT; isec += rli->secs_per_blk) {
+		bhs[count] = sb_getblk(sb, rli->blocks[isec]);
+		if (bhs[count])
+			count++;
+
+		if ((count == RFS_LOG_PREFETCH_BLOCKS) || 
+				(isec + rli->secs_per_blk >= RFS_LOG_MAX_COUNT)) {
+			/* no wait, log_read() waits for the completion */
+			ll_rw_block(READ, count, bhs);
+			for (i = 0; i < count; i++)
+				brelse(bhs[i]);
+			count = 0;
+		}
+	}
+}
+
 /**
  * get the index of a log with max sequence in log file
  * @param sb super block
@@ -1028,6 +1107,8 @@ int __log_replay(struct super_block *sb)
 	unsigned int last_index = 0, index;
 	int ret = 0;
 
+	__log_prefetch(sb);
+
 	if ((ret = __log_get_trans(sb, &last_index))) {
 		if (ret == -ENOENT) {
 			/* empty logfile. point first entry */
@@ -757,6 +757,13 @@ int rfs_sync_vol(struct super_block *sb)
 {
 	int err;
 
+	/* log records should reach the disk before metadata */
+	if (RFS_LOG_I(sb)) {
+		err = rfs_log_wait_records(sb);
+		if (err)
+			return err;
+	}
+
 	/* fat cache sync */
 	fat_lock(sb);
 	rfs_fcache_sync(sb, 0);
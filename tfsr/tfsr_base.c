@@ -46,6 +46,8 @@ static stl_info_t stl_info_list[FSR_MAX_VOLUMES * MAX_FLASH_PARTITIONS];
 
 int (*sec_stl_delete)(dev_t dev, u32 start, u32 nums, u32 b_size) = NULL;
 EXPORT_SYMBOL(sec_stl_delete);
+int (*sec_stl_delete_ext)(dev_t dev, STL_DELETE_EXTENT_T *ext, u32 nr_ext, u32 b_size) = NULL;
+EXPORT_SYMBOL(sec_stl_delete_ext);
 
 /**
  * fsr_get_vol_spec - get a volume instance